@@ -0,0 +1,317 @@
+// contra_bench: micro-benchmark cho các hàm tốn kém nhất mỗi tick, và chế độ headless.
+//
+// Cách dùng:
+//   contra_bench [--case NAME] [--sizes 10,100,...] [--widths 100,1000,...] [--reps N] [--budget S] [--tick-rate HZ]
+//   contra_bench --headless [ticks] [--idle] [--tick-rate HZ] [--discrete] [--full-sim]
+//
+// Kết quả in ra stdout dạng CSV (một dòng cho mỗi case × số entity × độ rộng map) để vẽ
+// đường scaling trước/sau tối ưu. ns_per_op là thời gian cho một đơn vị trong cột "op".
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Headless.hpp"
+#include "World.hpp"
+#include "map.hpp"
+#include "fixtures.hpp"
+
+namespace {
+
+// Một fixture đã dựng sẵn, mỗi lần tick() chạy đúng một bước mô phỏng của phần cần đo
+class BenchFixture {
+public:
+    virtual ~BenchFixture() {}
+    virtual void tick(float dt) = 0;
+    virtual long opsPerTick() const = 0;
+};
+
+struct BenchCase {
+    const char* name;
+    const char* op;     // Đơn vị của ns_per_op
+    int ticks;          // Số tick đo mỗi lần lặp
+    std::unique_ptr<BenchFixture> (*make)(int n, const TileMap& map);
+};
+
+// --- Player::update (chủ yếu là checkMapCollision) ---
+class PlayerFixture : public BenchFixture {
+public:
+    PlayerFixture(int n, const TileMap& p_map) : map(p_map) {
+        std::vector<float> xs = fixtures::spawnXs(map, n, World::PLAYER_STANDARD_FRAME_W);
+        float y = static_cast<float>(fixtures::GROUND_ROW * LOGICAL_TILE_HEIGHT - World::PLAYER_STANDARD_FRAME_H);
+        players.reserve(n);
+        for (float x : xs) {
+            players.emplace_back(vector2d{x, y}, World::PLAYER_STANDARD_FRAME_W, World::PLAYER_STANDARD_FRAME_H,
+                                 World::PLAYER_LYING_FRAME_W, World::PLAYER_LYING_FRAME_H);
+        }
+        // Một nửa chạy sang phải, một nửa sang trái để đi qua nhánh kiểm tra tường hai phía
+        keysRight[SDL_SCANCODE_RIGHT] = 1;
+        keysLeft[SDL_SCANCODE_LEFT] = 1;
+    }
+    void tick(float dt) override {
+        for (size_t i = 0; i < players.size(); ++i) {
+            players[i].handleInput((i & 1) ? keysLeft : keysRight);
+            players[i].update(dt, map);
+        }
+    }
+    long opsPerTick() const override { return static_cast<long>(players.size()); }
+private:
+    const TileMap& map;
+    std::vector<Player> players;
+    Uint8 keysRight[SDL_NUM_SCANCODES] = {};
+    Uint8 keysLeft[SDL_NUM_SCANCODES] = {};
+};
+
+// --- EnemyPool::update (dò đất và tường trên TileMap) ---
+class EnemyFixture : public BenchFixture {
+public:
+    EnemyFixture(int n, const TileMap& p_map) : map(p_map) {
+        float y = static_cast<float>(fixtures::GROUND_ROW * LOGICAL_TILE_HEIGHT - 72);
+        enemies.reserve(n);
+        for (float x : fixtures::spawnXs(map, n, 40.0f)) enemies.spawn(vector2d{x, y});
+    }
+    void tick(float dt) override { enemies.update(dt, map); }
+    long opsPerTick() const override { return static_cast<long>(enemies.size()); }
+private:
+    const TileMap& map;
+    EnemyPool enemies;
+};
+
+// --- TurretPool::update (khoảng cách tới player, hẹn giờ bắn) ---
+class TurretFixture : public BenchFixture {
+public:
+    TurretFixture(int n, const TileMap& map)
+        : player(vector2d{0.0f, 0.0f}, World::PLAYER_STANDARD_FRAME_W, World::PLAYER_STANDARD_FRAME_H,
+                 World::PLAYER_LYING_FRAME_W, World::PLAYER_LYING_FRAME_H),
+          turrets(SpriteSheet(), SpriteSheet(), SpriteRegion(), LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT) {
+        float y = static_cast<float>((fixtures::GROUND_ROW - 1) * LOGICAL_TILE_HEIGHT);
+        std::vector<float> xs = fixtures::spawnXs(map, n, static_cast<float>(LOGICAL_TILE_WIDTH));
+        turrets.reserve(n);
+        for (float x : xs) turrets.spawn(vector2d{x, y});
+        // Player đứng giữa map: một phần turret trong tầm bắn, phần còn lại ngoài tầm
+        float midX = map.getWorldWidth() / 2.0f;
+        player.setPos(vector2d{midX, static_cast<float>(fixtures::GROUND_ROW * LOGICAL_TILE_HEIGHT - World::PLAYER_STANDARD_FRAME_H)});
+    }
+    void tick(float dt) override {
+        turrets.update(dt, &player, enemyBullets);
+        enemyBullets.clear();
+    }
+    long opsPerTick() const override { return static_cast<long>(turrets.size()); }
+private:
+    Player player;
+    TurretPool turrets;
+    BulletPool enemyBullets{World::ENEMY_BULLET_CAPACITY};
+};
+
+// --- World::step: va chạm đạn player × (enemy + turret) ---
+// N đạn bay ngang trên trời, N/2 lính và N/2 turret trên mặt đất: không viên nào trúng.
+// Với vòng lặp lồng nhau đây là trường hợp xấu nhất (mỗi viên quét hết danh sách mục tiêu).
+class BulletCollisionFixture : public BenchFixture {
+public:
+    BulletCollisionFixture(int n, const TileMap& map)
+        : world(map, WorldTextures{}), bulletCount(n) {
+        int targets = std::max(1, n / 2);
+        float enemyY = static_cast<float>(fixtures::GROUND_ROW * LOGICAL_TILE_HEIGHT - 72);
+        for (float x : fixtures::spawnXs(map, targets, 40.0f)) world.enemies.spawn(vector2d{x, enemyY});
+        float turretY = static_cast<float>((fixtures::GROUND_ROW - 1) * LOGICAL_TILE_HEIGHT);
+        for (float x : fixtures::spawnXs(map, targets, static_cast<float>(LOGICAL_TILE_WIDTH), fixtures::SEED + 7)) {
+            world.turrets.spawn(vector2d{x, turretY});
+        }
+
+        world.playerBullets = BulletPool(n); // Pool mặc định của World chỉ đủ cho gameplay thật
+        std::mt19937 rng(fixtures::SEED + 13);
+        float mapW = map.getWorldWidth();
+        std::uniform_real_distribution<float> xDist(0.0f, mapW);
+        std::uniform_real_distribution<float> yDist(0.0f, static_cast<float>((fixtures::GROUND_ROW - 1) * LOGICAL_TILE_HEIGHT - 40));
+        for (int i = 0; i < n; ++i) {
+            float vx = (i & 1) ? -600.0f : 600.0f;
+            world.playerBullets.spawn(vector2d{xDist(rng), yDist(rng)}, vector2d{vx, 0.0f},
+                                      World::PLAYER_BULLET_RENDER_WIDTH, World::PLAYER_BULLET_RENDER_HEIGHT, 0);
+        }
+    }
+    void tick(float dt) override { world.step(dt); }
+    long opsPerTick() const override { return bulletCount; }
+private:
+    World world;
+    long bulletCount;
+};
+
+// --- World::step với vùng hoạt động ---
+// N/2 lính và N/2 turret rải khắp map, camera đứng ở đầu map. full update mọi entity mỗi tick,
+// active chỉ update entity quanh camera: thời gian mỗi tick gần như không đổi theo N và độ rộng map.
+template <bool ACTIVITY_REGION>
+class WorldStepFixture : public BenchFixture {
+public:
+    WorldStepFixture(int n, const TileMap& map) : world(map, WorldTextures{}), entityCount(n) {
+        int half = std::max(1, n / 2);
+        float enemyY = static_cast<float>(fixtures::GROUND_ROW * LOGICAL_TILE_HEIGHT - 72);
+        for (float x : fixtures::spawnXs(map, half, 40.0f)) world.enemies.spawn(vector2d{x, enemyY});
+        float turretY = static_cast<float>((fixtures::GROUND_ROW - 1) * LOGICAL_TILE_HEIGHT);
+        for (float x : fixtures::spawnXs(map, half, static_cast<float>(LOGICAL_TILE_WIDTH), fixtures::SEED + 7)) {
+            world.turrets.spawn(vector2d{x, turretY});
+        }
+        world.activityRegion = ACTIVITY_REGION;
+        world.viewWidth = 1024;
+    }
+    void tick(float dt) override { world.step(dt); }
+    long opsPerTick() const override { return entityCount; }
+private:
+    World world;
+    long entityCount;
+};
+
+// --- Kiểm tra AABB: một hộp query (player) × N đạn ---
+// pairwise là đường cũ: dựng SDL_Rect bằng getWorldHitbox() (round) rồi SDL_HasIntersection từng cặp.
+// batch gom hộp float SoA bằng gatherBounds() rồi chạy kernel aabb::intersectMask (SIMD),
+// batch_scalar cùng dữ liệu nhưng chạy bản scalar của kernel.
+enum class AabbMode { PAIRWISE, BATCH, BATCH_SCALAR };
+
+template <AabbMode MODE>
+class AabbFixture : public BenchFixture {
+public:
+    AabbFixture(int n, const TileMap& map) : bullets(static_cast<std::size_t>(n)) {
+        std::mt19937 rng(fixtures::SEED + 21);
+        std::uniform_real_distribution<float> xDist(0.0f, map.getWorldWidth());
+        std::uniform_real_distribution<float> yDist(0.0f, map.getWorldHeight());
+        for (int i = 0; i < n; ++i) {
+            bullets.spawn(vector2d{xDist(rng), yDist(rng)}, vector2d{0.0f, 0.0f},
+                          TurretPool::TURRET_BULLET_RENDER_W, TurretPool::TURRET_BULLET_RENDER_H, 0);
+        }
+        // Query cỡ một tile: trúng một phần nhỏ số đạn như khi player đứng giữa làn đạn
+        query = SDL_Rect{ static_cast<int>(map.getWorldWidth() / 2), 0, LOGICAL_TILE_WIDTH, static_cast<int>(map.getWorldHeight()) };
+    }
+    void tick(float) override {
+        if (MODE == AabbMode::PAIRWISE) {
+            for (std::size_t i = 0; i < bullets.size(); ++i) {
+                SDL_Rect r = bullets.getWorldHitbox(i);
+                if (SDL_HasIntersection(&query, &r)) hits++;
+            }
+            return;
+        }
+        bullets.gatherBounds(0.0f, boxes);
+        mask.resize((bullets.size() + 31) / 32);
+        if (MODE == AabbMode::BATCH) hits += boxes.intersect(aabb::fromRect(query), 0, boxes.size(), mask.data());
+        else hits += aabb::intersectMaskScalar(aabb::fromRect(query), boxes.minXData(), boxes.minYData(),
+                                               boxes.maxXData(), boxes.maxYData(), boxes.size(), mask.data());
+    }
+    long opsPerTick() const override { return static_cast<long>(bullets.size()); }
+    ~AabbFixture() override { if (hits < 0) std::cerr << hits; } // Giữ kết quả để compiler không bỏ vòng lặp
+private:
+    BulletPool bullets;
+    AabbBatch boxes;
+    std::vector<std::uint32_t> mask;
+    SDL_Rect query;
+    long hits = 0;
+};
+
+template <typename T>
+std::unique_ptr<BenchFixture> makeFixture(int n, const TileMap& map) {
+    return std::unique_ptr<BenchFixture>(new T(n, map));
+}
+
+const BenchCase CASES[] = {
+    { "player_update",    "player", 50, makeFixture<PlayerFixture> },
+    { "enemy_update",     "enemy",  50, makeFixture<EnemyFixture> },
+    { "turret_update",    "turret", 50, makeFixture<TurretFixture> },
+    { "bullet_collision", "bullet", 20, makeFixture<BulletCollisionFixture> },
+    { "world_step_full",   "entity", 20, makeFixture<WorldStepFixture<false>> },
+    { "world_step_active", "entity", 20, makeFixture<WorldStepFixture<true>> },
+    { "aabb_pairwise",     "box",    50, makeFixture<AabbFixture<AabbMode::PAIRWISE>> },
+    { "aabb_batch",        "box",    50, makeFixture<AabbFixture<AabbMode::BATCH>> },
+    { "aabb_batch_scalar", "box",    50, makeFixture<AabbFixture<AabbMode::BATCH_SCALAR>> },
+};
+
+std::vector<int> parseList(const char* text) {
+    std::vector<int> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int v = std::atoi(item.c_str());
+        if (v > 0) values.push_back(v);
+    }
+    return values;
+}
+
+int runHeadlessMode(int argc, char* argv[]) {
+    HeadlessOptions options;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--idle") == 0) options.autoPlay = false;
+        else if (std::strcmp(argv[i], "--discrete") == 0) options.sweptCollision = false;
+        else if (std::strcmp(argv[i], "--full-sim") == 0) options.activityRegion = false;
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) options.timeStep = World::timeStepForRate(std::atoi(argv[++i]));
+        else if (std::atol(argv[i]) > 0) options.ticks = std::atol(argv[i]);
+    }
+    printHeadlessStats(runHeadless(options));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--headless") == 0) return runHeadlessMode(argc, argv);
+
+    std::vector<int> sizes = {10, 100, 1000, 10000, 100000};
+    std::vector<int> widths = {100, 1000, 10000};
+    std::string onlyCase;
+    int reps = 3;
+    double budgetSeconds = 2.0; // Vượt quá thì bỏ qua các kích thước lớn hơn của case đó
+    int tickRate = World::DEFAULT_TICK_RATE;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--case" && hasValue) onlyCase = argv[++i];
+        else if (arg == "--sizes" && hasValue) sizes = parseList(argv[++i]);
+        else if (arg == "--widths" && hasValue) widths = parseList(argv[++i]);
+        else if (arg == "--reps" && hasValue) reps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--budget" && hasValue) budgetSeconds = std::atof(argv[++i]);
+        else if (arg == "--tick-rate" && hasValue) tickRate = std::atoi(argv[++i]);
+        else { std::cerr << "Unknown argument: " << arg << std::endl; return 1; }
+    }
+    std::sort(sizes.begin(), sizes.end());
+
+    const float timeStep = World::timeStepForRate(tickRate);
+    std::cerr << "aabb kernel: " << aabb::kernelName() << std::endl;
+    std::cout << "case,op,entities,map_cols,ticks,ns_per_tick,ns_per_op,status" << std::endl;
+
+    for (const BenchCase& bc : CASES) {
+        if (!onlyCase.empty() && onlyCase != bc.name) continue;
+        for (int width : widths) {
+            TileMap map = fixtures::makeMap(width);
+            // Bản CONTRA_FIXED_POINT: map rộng từ 32768 px trở lên tràn toạ độ 16.16, không đo
+            bool outOfRange = !map.fitsPhysicsRange();
+            bool overBudget = false;
+            for (int n : sizes) {
+                if (overBudget || outOfRange) {
+                    std::cout << bc.name << "," << bc.op << "," << n << "," << width << "," << bc.ticks << ",,,skipped" << std::endl;
+                    continue;
+                }
+                double best = std::numeric_limits<double>::max();
+                long ops = 0;
+                for (int r = 0; r < reps; ++r) {
+                    std::unique_ptr<BenchFixture> fixture = bc.make(n, map);
+                    ops = fixture->opsPerTick();
+                    fixture->tick(timeStep); // Warm-up
+                    auto start = std::chrono::steady_clock::now();
+                    for (int t = 0; t < bc.ticks; ++t) fixture->tick(timeStep);
+                    auto end = std::chrono::steady_clock::now();
+                    best = std::min(best, std::chrono::duration<double>(end - start).count());
+                    if (best > budgetSeconds) break;
+                }
+                double nsPerTick = best * 1e9 / bc.ticks;
+                double nsPerOp = ops > 0 ? nsPerTick / ops : 0.0;
+                std::cout << bc.name << "," << bc.op << "," << n << "," << width << "," << bc.ticks << ","
+                          << nsPerTick << "," << nsPerOp << ",ok" << std::endl;
+                overBudget = best > budgetSeconds;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+// Fixture tái lập được cho contra_bench: map và vị trí entity sinh từ seed cố định,
+// cùng tham số thì mọi lần chạy (và mọi máy) đều cho cùng một bố cục.
+#include <random>
+#include <vector>
+#include "map.hpp"
+#include "TileMap.hpp"
+
+namespace fixtures {
+    const unsigned SEED = 1987;
+    const int MAP_ROWS = 7;
+    const int GROUND_ROW = 3;
+
+    // Map có cấu trúc giống stage 1: hàng 3 là mặt đất có hố, hàng 2 có platform
+    // và vài khối tường, hàng cuối là nước xen cỏ. Cột 0..3 luôn là đất.
+    inline TileMap makeMap(int cols, unsigned seed = SEED) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> roll(0.0f, 1.0f);
+        std::vector<std::vector<int>> map(MAP_ROWS, std::vector<int>(cols, 0));
+        for (int c = 0; c < cols; ++c) {
+            bool safe = c < 4;
+            map[GROUND_ROW][c] = (safe || roll(rng) < 0.85f) ? 1 : 0;
+            float r = roll(rng);
+            if (!safe && r < 0.05f) map[GROUND_ROW - 1][c] = 2;      // Tường
+            else if (!safe && r < 0.25f) map[GROUND_ROW - 1][c] = 1; // Platform
+            if (roll(rng) < 0.2f) map[GROUND_ROW + 1][c] = 1;
+            map[MAP_ROWS - 1][c] = (roll(rng) < 0.7f) ? 3 : 1;
+        }
+        return TileMap(map, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT);
+    }
+
+    // Các cột có đất ở hàng 3 và khoảng trống phía trên, đặt entity đứng được
+    inline std::vector<int> standableColumns(const TileMap& map) {
+        std::vector<int> cols;
+        for (int c = 0; c < map.getCols(); ++c) {
+            if (map.tileAt(c, GROUND_ROW) == TILE_GRASS && map.tileAt(c, GROUND_ROW - 1) == TILE_EMPTY) cols.push_back(c);
+        }
+        return cols;
+    }
+
+    // Chọn ngẫu nhiên (có seed) count cột đứng được, trả về toạ độ x thế giới
+    inline std::vector<float> spawnXs(const TileMap& map, int count, float entityWidth, unsigned seed = SEED) {
+        std::vector<int> cols = standableColumns(map);
+        std::mt19937 rng(seed + 1);
+        std::uniform_int_distribution<size_t> pick(0, cols.empty() ? 0 : cols.size() - 1);
+        std::uniform_real_distribution<float> offset(0.0f, LOGICAL_TILE_WIDTH - entityWidth);
+        std::vector<float> xs;
+        xs.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            int c = cols.empty() ? 0 : cols[pick(rng)];
+            xs.push_back(c * static_cast<float>(LOGICAL_TILE_WIDTH) + offset(rng));
+        }
+        return xs;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward
+#endif
+
+// Kiểm tra giao nhau AABB theo lô: một hộp query với một mảng hộp SoA float liên tục,
+// mỗi lần 8 hộp (AVX2) hoặc 4 hộp (SSE2), phần lẻ và máy không có SIMD chạy vòng scalar.
+// Giao nhau là giao chặt như SDL_HasIntersection: chỉ chạm mép thì không tính.
+namespace aabb
+{
+    struct Box {
+        float minX, minY, maxX, maxY;
+    };
+
+    inline Box fromRect(const SDL_Rect& r) {
+        return Box{ static_cast<float>(r.x), static_cast<float>(r.y),
+                    static_cast<float>(r.x + r.w), static_cast<float>(r.y + r.h) };
+    }
+
+    // Bit k của outMask[k / 32] = hộp k giao query. outMask cần (count + 31) / 32 phần tử.
+    // Trả về số hộp giao.
+    std::size_t intersectMask(const Box& query, const float* minX, const float* minY, const float* maxX, const float* maxY,
+                              std::size_t count, std::uint32_t* outMask);
+    // Bản scalar, dùng cho phần lẻ và để benchmark so sánh
+    std::size_t intersectMaskScalar(const Box& query, const float* minX, const float* minY, const float* maxX, const float* maxY,
+                                    std::size_t count, std::uint32_t* outMask);
+    const char* kernelName(); // "avx2", "sse2" hoặc "scalar", chọn lúc biên dịch
+
+    // Chỉ số bit thấp nhất đang bật (bits != 0)
+    inline int lowestBit(std::uint32_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(bits);
+#endif
+    }
+}
+
+// Danh sách hộp dạng structure-of-arrays cho aabb::intersectMask
+class AabbBatch {
+public:
+    void clear() { minX.clear(); minY.clear(); maxX.clear(); maxY.clear(); }
+    void reserve(std::size_t n) { minX.reserve(n); minY.reserve(n); maxX.reserve(n); maxY.reserve(n); }
+    void resize(std::size_t n) { minX.resize(n); minY.resize(n); maxX.resize(n); maxY.resize(n); }
+    void push(const aabb::Box& b) { minX.push_back(b.minX); minY.push_back(b.minY); maxX.push_back(b.maxX); maxY.push_back(b.maxY); }
+    void set(std::size_t k, const aabb::Box& b) { minX[k] = b.minX; minY[k] = b.minY; maxX[k] = b.maxX; maxY[k] = b.maxY; }
+    std::size_t size() const { return minX.size(); }
+    const float* minXData() const { return minX.data(); }
+    const float* minYData() const { return minY.data(); }
+    const float* maxXData() const { return maxX.data(); }
+    const float* maxYData() const { return maxY.data(); }
+
+    // Kiểm tra các hộp [first, first + count), bit j của outMask ứng với hộp first + j
+    std::size_t intersect(const aabb::Box& query, std::size_t first, std::size_t count, std::uint32_t* outMask) const {
+        return aabb::intersectMask(query, minX.data() + first, minY.data() + first, maxX.data() + first, maxY.data() + first, count, outMask);
+    }
+
+private:
+    std::vector<float> minX, minY, maxX, maxY;
+};
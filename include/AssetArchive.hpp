@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "PackFormat.hpp"
+
+// Archive tài nguyên do contra_pack tạo, map vào bộ nhớ (mmap / MapViewOfFile) thay cho ~30 file rời.
+// Không có bước giải mã: surface và Mix_Chunk trỏ thẳng vào các trang đã map, texture upload từ đó.
+// Mọi thứ lấy ra (surface, chunk, music, font) dùng bộ nhớ của archive nên phải được giải phóng trước
+// khi đóng archive. Tên entry là đường dẫn như game vẫn dùng để load file rời.
+class AssetArchive {
+public:
+    static constexpr const char* DEFAULT_PATH = "res/assets.pak";
+
+    AssetArchive();
+    ~AssetArchive();
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    // false nếu không có file (game dùng file rời) hoặc file sai định dạng (có log)
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+    int size() const { return header ? static_cast<int>(header->entryCount) : 0; }
+
+    const pack::Entry* find(const std::string& name) const; // nullptr nếu không có
+    bool contains(const std::string& name) const { return find(name) != nullptr; }
+
+    // nullptr nếu không có entry đúng loại. Surface không sở hữu pixel: SDL_FreeSurface chỉ xóa phần đầu.
+    SDL_Surface* surface(const std::string& name) const;
+    SDL_Texture* texture(SDL_Renderer* renderer, const std::string& name) const;
+    Mix_Chunk* sound(const std::string& name) const; // nullptr nếu mixer không mở đúng định dạng PCM của archive
+    Mix_Music* music(const std::string& name) const;
+    TTF_Font* font(const std::string& name, int ptsize) const;
+
+private:
+    const std::uint8_t* base;
+    std::size_t length;
+    const pack::Header* header;
+    const pack::Entry* entries;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+
+    bool validate() const;
+    const pack::Entry* find(const std::string& name, pack::EntryType type) const;
+    std::uint8_t* data(const pack::Entry& entry) const { return const_cast<std::uint8_t*>(base + entry.offset); }
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Đọc và giải mã file tài nguyên trên một nhóm worker thread: ảnh thành SDL_Surface (file .qoi cạnh ảnh nếu có,
+// không thì IMG_Load; xem Qoi.hpp),
+// âm thanh thành Mix_Chunk PCM (Mix_LoadWAV) hoặc Mix_Music. Job chạy theo thứ tự gửi, nên gửi trước thứ
+// cần hiện sớm (ảnh menu). Main thread hỏi isReady() mỗi frame rồi take*() kết quả; tạo SDL_Texture
+// (takeTexture) luôn ở main thread vì renderer không an toàn đa luồng.
+// Font không qua đây: mọi TTF_Font dùng chung một FT_Library của SDL_ttf, mở song song không an toàn.
+class AssetLoader {
+public:
+    static constexpr int MAX_WORKERS = 4; // Chỉ ~30 file, nhiều thread hơn chỉ tranh nhau đĩa
+
+    explicit AssetLoader(int p_workerCount = defaultWorkerCount());
+    ~AssetLoader(); // Dừng worker (job chưa chạy bị bỏ) và giải phóng kết quả chưa ai lấy
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Gửi job, trả về id để hỏi kết quả. Ảnh giải mã thẳng ra format: RGBA32 cho atlas, định dạng gốc của
+    // renderer (qoi::preferredFormat) cho ảnh upload nguyên tấm.
+    int loadImage(const std::string& path, Uint32 format = SDL_PIXELFORMAT_RGBA32);
+    int loadSound(const std::string& path);
+    int loadMusic(const std::string& path);
+
+    bool isReady(int id) const { return jobs[id]->finished.load(std::memory_order_acquire); }
+    void wait(int id);
+    void waitAll();
+    int size() const { return static_cast<int>(jobs.size()); }
+    int finishedCount() const { return finishedJobs.load(std::memory_order_acquire); }
+    bool done() const { return finishedCount() == size(); }
+    float progress() const { return jobs.empty() ? 1.0f : static_cast<float>(finishedCount()) / size(); }
+    int workerCount() const { return static_cast<int>(workers.size()); }
+
+    // Chuyển quyền sở hữu kết quả cho người gọi (chờ nếu job chưa xong). nullptr nếu lỗi, lỗi đã được log.
+    SDL_Surface* takeSurface(int id);
+    SDL_Texture* takeTexture(int id, SDL_Renderer* renderer); // Upload rồi giải phóng surface
+    Mix_Chunk* takeSound(int id);
+    Mix_Music* takeMusic(int id);
+
+    static int defaultWorkerCount();
+
+private:
+    enum class Kind : std::uint8_t { IMAGE, SOUND, MUSIC };
+
+    struct Job {
+        Kind kind;
+        std::string path;
+        Uint32 format = SDL_PIXELFORMAT_RGBA32; // Định dạng surface của ảnh
+        std::atomic<bool> finished{ false };
+        // Kết quả, worker ghi trước khi đặt finished
+        SDL_Surface* surface = nullptr;
+        Mix_Chunk* chunk = nullptr;
+        Mix_Music* music = nullptr;
+        std::string error;
+    };
+
+    std::vector<std::unique_ptr<Job>> jobs; // Chỉ main thread thêm; worker giữ con trỏ tới Job
+    std::deque<Job*> queue;
+    std::mutex mutex;
+    std::condition_variable wake;     // Có job mới hoặc đang dừng
+    std::condition_variable finished; // Một job vừa xong
+    bool stopping;
+    std::atomic<int> finishedJobs;
+    std::vector<std::thread> workers;
+
+    int submit(Kind kind, const std::string& path, Uint32 format = SDL_PIXELFORMAT_RGBA32);
+    Job& result(int id, Kind kind);
+    void workerLoop();
+    static void run(Job& job);
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SpriteRegion.hpp"
+#include "AssetLoader.hpp"
+#include "TextureAtlas.hpp"
+
+class AssetArchive;
+
+// Handle có kiểu tới một tài nguyên của AssetManager: không đổi SpriteHandle thành SoundHandle được
+template<typename Tag>
+struct AssetHandle {
+    int id = -1;
+    explicit operator bool() const { return id >= 0; }
+};
+using SpriteHandle = AssetHandle<struct SpriteTag>;   // Sprite sheet trong atlas
+using TextureHandle = AssetHandle<struct TextureTag>; // Texture riêng (ảnh menu, tileset)
+using SoundHandle = AssetHandle<struct SoundTag>;
+using MusicHandle = AssetHandle<struct MusicTag>;
+
+// Sở hữu mọi texture/âm thanh của game, khóa theo đường dẫn. Xin cùng một file hai lần trả về cùng handle
+// và tăng số tham chiếu; release() về 0 thì giải phóng (ô atlas của sprite giữ tới khi hủy manager vì
+// không xếp lại trang được). Cách dùng: xin handle lúc khởi động (file được giải mã trên worker của
+// AssetLoader), chờ loadingDone() trong màn loading, build() một lần rồi đọc qua sheet()/get().
+// Xin thêm sau build() thì load đồng bộ; sprite khi đó nằm trong texture riêng.
+// Có AssetArchive thì file nằm trong archive được lấy thẳng từ vùng đã map, không qua worker.
+// Metadata sprite sheet (kích thước frame, số cột) tính một lần trong build() và trả ra qua sheet().
+// Hot reload (bật khi tạo manager): pollChanges() so thời gian sửa file, file đổi thì chỉ load lại tài nguyên
+// đó, tại chỗ (handle và con trỏ texture giữ nguyên). Khi bật, atlas không gộp các file khác tên cùng nội
+// dung vào một ô: sheet đã chép ra Player/các pool vẫn trỏ vào ô cũ, nên sửa một file không được ghi đè
+// sprite của file kia. Music đang stream nên không reload.
+class AssetManager {
+public:
+    static constexpr double POLL_INTERVAL = 0.5; // Giây giữa hai lần hỏi thời gian sửa file
+
+    // archive (có thể nullptr) phải sống lâu hơn manager
+    explicit AssetManager(SDL_Renderer* p_renderer, const AssetArchive* p_archive = nullptr, bool p_hotReload = false);
+    ~AssetManager();
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Xin tài nguyên (tăng số tham chiếu). Cùng file nhưng khác số cột là hai sheet, chung một ô atlas.
+    SpriteHandle sprite(const std::string& path, int columns = 1);
+    TextureHandle texture(const std::string& path);
+    SoundHandle sound(const std::string& path);
+    MusicHandle music(const std::string& path);
+
+    void release(SpriteHandle& handle);
+    void release(TextureHandle& handle);
+    void release(SoundHandle& handle);
+    void release(MusicHandle& handle);
+
+    // --- Giai đoạn load ---
+    // Loader chung, để giải mã cả file không do manager giữ (ảnh nền chunk). Chỉ dùng trước build().
+    AssetLoader& loader() { return *asyncLoader; }
+    bool loadingDone() const { return !asyncLoader || asyncLoader->done(); }
+    float progress() const { return asyncLoader ? asyncLoader->progress() : 1.0f; }
+    int fileCount() const { return asyncLoader ? asyncLoader->size() : 0; }
+    int workerCount() const { return asyncLoader ? asyncLoader->workerCount() : 0; }
+    // Chờ mọi file, xếp atlas, tính metadata sheet, upload texture rồi dừng worker. false nếu có file lỗi.
+    bool build();
+
+    // --- Truy cập ---
+    const SpriteSheet& sheet(SpriteHandle handle) const;
+    SDL_Texture* get(TextureHandle handle); // Trước build(): upload ngay khi file xong, nullptr nếu chưa
+    Mix_Chunk* get(SoundHandle handle) const;
+    Mix_Music* get(MusicHandle handle) const;
+
+    // Load lại các file đã sửa trên đĩa, tối đa mỗi POLL_INTERVAL một lần. Trả về số tài nguyên đã load lại
+    // (luôn 0 nếu manager tạo không bật hot reload).
+    int pollChanges(double now);
+    int liveCount() const; // Số tài nguyên đang được giữ
+
+private:
+    enum class Kind : std::uint8_t { SPRITE, TEXTURE, SOUND, MUSIC };
+
+    struct Entry {
+        Kind kind;
+        std::string path;
+        int columns;
+        int refs;
+        int job;         // Job trong loader, -1 nếu đã lấy kết quả
+        int atlasHandle; // Sprite trong atlas, -1 nếu sprite nằm trong texture riêng
+        SpriteSheet sheet;
+        SDL_Texture* texture = nullptr; // Texture riêng, hoặc texture của sprite xin sau build()
+        Mix_Chunk* chunk = nullptr;
+        Mix_Music* music = nullptr;
+        std::filesystem::file_time_type modified;
+    };
+
+    SDL_Renderer* renderer;
+    const AssetArchive* archive;
+    Uint32 textureFormat; // Định dạng gốc của renderer: ảnh texture riêng giải mã thẳng ra đây
+    std::unique_ptr<AssetLoader> asyncLoader; // nullptr sau build()
+    std::unique_ptr<TextureAtlas> atlas;
+    bool built;
+    bool hotReload;
+    std::vector<Entry> entries; // Id của handle là chỉ số; entry đã giải phóng có refs = 0
+    std::unordered_map<std::string, int> index;
+    double lastPoll;
+
+    static std::string key(Kind kind, const std::string& path, int columns);
+    static std::filesystem::file_time_type modifiedTime(const std::string& path);
+    int acquire(Kind kind, const std::string& path, int columns);
+    bool loadArchived(Entry& entry); // false nếu archive không có file này
+    void load(Entry& entry);         // Load đồng bộ, sau build()
+    void collect(Entry& entry);      // Lấy kết quả từ loader
+    void unload(int id);
+    bool reload(Entry& entry);
+    bool reloadTexture(SDL_Texture* texture, const std::string& path);
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math.hpp"
+#include "AabbBatch.hpp"
+#include "Fixed.hpp"
+#include "SpriteRegion.hpp"
+
+struct RenderSnapshot; // Forward declaration
+
+// Kho đạn dung lượng cố định, lưu dạng structure-of-arrays (mỗi thuộc tính một mảng liên tục).
+// Toàn bộ bộ nhớ cấp phát một lần trong constructor: spawn() và remove() trong vòng lặp tick
+// không new/delete. Xóa bằng swap-and-pop nên thứ tự đạn không được giữ nguyên.
+class BulletPool {
+public:
+    static constexpr float MAX_LIFETIME = 2.0f; // Giây, như Bullet cũ
+
+    explicit BulletPool(std::size_t p_capacity = 0);
+
+    // Trả về false (bỏ viên đạn) nếu pool đã đầy
+    bool spawn(vector2d p_pos, vector2d p_vel, int p_renderW, int p_renderH, std::uint16_t p_texId);
+    // Như trên, toạ độ đã ở kiểu vật lý (không đổi qua float, giữ nguyên giá trị ở chế độ CONTRA_FIXED_POINT)
+    bool spawn(phys::Vec2 p_pos, phys::Vec2 p_vel, int p_renderW, int p_renderH, std::uint16_t p_texId);
+    // Tích phân vị trí, tăng lifetime, rồi xóa các viên hết hạn
+    void update(float dt);
+    // Swap-and-pop: viên cuối chuyển vào chỗ i, vòng lặp gọi remove(i) không được ++i
+    void remove(std::size_t i);
+    void clear() { count = 0; }
+
+    // Id của sprite trong bảng của pool, thêm mới nếu chưa có. Nên đăng ký trước khi vào vòng lặp tick.
+    std::uint16_t spriteId(const SpriteRegion& sprite);
+    SpriteRegion sprite(std::uint16_t id) const { return id < sprites.size() ? sprites[id] : SpriteRegion(); }
+
+    // --- Iteration API: chỉ số hợp lệ là [0, size()) ---
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return posX.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == posX.size(); }
+
+    phys::Real x(std::size_t i) const { return posX[i]; }
+    phys::Real y(std::size_t i) const { return posY[i]; }
+    phys::Real velocityX(std::size_t i) const { return velX[i]; }
+    phys::Real velocityY(std::size_t i) const { return velY[i]; }
+    int renderWidth(std::size_t i) const { return renderW[i]; }
+    int renderHeight(std::size_t i) const { return renderH[i]; }
+    std::uint16_t textureIndex(std::size_t i) const { return texId[i]; }
+    SDL_Rect getWorldHitbox(std::size_t i) const {
+        return SDL_Rect{ phys::roundToInt(posX[i]), phys::roundToInt(posY[i]), renderW[i], renderH[i] };
+    }
+
+    // Ghi vào out hộp bao của đường bay trong dt giây vừa qua (dt = 0: hộp cuối tick), nới thêm
+    // nửa pixel mỗi phía để chứa hitbox đã làm tròn của getWorldHitbox. Dùng làm bộ lọc thô.
+    void gatherBounds(float dt, AabbBatch& out) const;
+
+    // Định nghĩa trong render.cpp. Ghi đạn chạm đoạn x [minX, maxX] vào snapshot
+    void collect(RenderSnapshot& out, float minX, float maxX) const;
+
+private:
+    std::vector<phys::Real> posX, posY;
+    std::vector<phys::Real> velX, velY;
+    std::vector<phys::Real> lifeTime;
+    std::vector<int> renderW, renderH;
+    std::vector<std::uint16_t> texId;
+    std::vector<phys::Real> prevX, prevY; // Vị trí đầu tick, chỉ render dùng
+    std::size_t count;
+
+    std::vector<SpriteRegion> sprites;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Ảnh nền màn chơi chia thành các dải dọc rộng CHUNK_WIDTH ngay khi load.
+// Ảnh gốc (9880 px) vượt giới hạn 8192 px texture của nhiều renderer, và chỉ ~1024 px được hiển thị
+// cùng lúc. Pixel từng dải giữ trên RAM dạng SDL_Surface; chỉ các dải trong khoảng
+// cameraX ± một màn hình có SDL_Texture trên GPU, dải xa hơn bị giải phóng texture.
+class ChunkedBackground {
+public:
+    static constexpr int CHUNK_WIDTH = 1024;
+
+    ChunkedBackground(SDL_Renderer* p_renderer, const char* p_filePath, int p_chunkWidth = CHUNK_WIDTH);
+    // Chia ảnh đã giải mã sẵn (vd. từ AssetLoader), nhận quyền sở hữu image. image = nullptr: nền rỗng.
+    ChunkedBackground(SDL_Renderer* p_renderer, SDL_Surface* p_image, int p_chunkWidth = CHUNK_WIDTH);
+    ~ChunkedBackground();
+    ChunkedBackground(const ChunkedBackground&) = delete;
+    ChunkedBackground& operator=(const ChunkedBackground&) = delete;
+
+    bool isLoaded() const { return !chunks.empty(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int residentCount() const;
+
+    // Tạo texture cho dải trong vùng [cameraX - screenWidth, cameraX + 2 * screenWidth), hủy texture
+    // các dải ngoài vùng. Gọi mỗi frame trước render().
+    void update(float cameraX, int screenWidth);
+    // Vẽ phần ảnh [cameraX, cameraX + screenWidth) × [cameraY, cameraY + screenHeight) lên toàn màn hình.
+    // Dải thấy được mà chưa có texture (camera nhảy xa) được tạo ngay.
+    void render(float cameraX, float cameraY, int screenWidth, int screenHeight);
+
+private:
+    struct Chunk {
+        SDL_Surface* surface;
+        SDL_Texture* texture; // nullptr khi không resident
+        int x, w;             // Vị trí và độ rộng trong ảnh gốc
+    };
+
+    SDL_Renderer* renderer;
+    int chunkWidth;
+    int width, height;
+    std::vector<Chunk> chunks;
+
+    void split(SDL_Surface* image);
+    bool makeResident(Chunk& chunk);
+    void evict(Chunk& chunk);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <algorithm> // Cho std::min, std::max, std::swap
+#include <cmath>     // Cho std::floor, std::ceil
+#include <cstdint>
+#include "Fixed.hpp"
+
+// Va chạm liên tục (swept AABB) cho vật nhanh như đạn. Ở tick rate thấp một viên đạn có thể
+// đi xa hơn bề rộng mục tiêu trong một tick, kiểm tra vị trí cuối tick sẽ bỏ sót.
+namespace collision
+{
+    // --- Phép toán số theo kiểu toạ độ --- (float, hoặc Fixed16 ở chế độ CONTRA_FIXED_POINT)
+    inline int floorInt(float v) { return static_cast<int>(std::floor(v)); }
+    inline int ceilInt(float v) { return static_cast<int>(std::ceil(v)); }
+    inline int floorInt(Fixed16 v) { return v.floorToInt(); }
+    inline int ceilInt(Fixed16 v) { return -(-v).floorToInt(); }
+    // num / delta (delta != 0). Bản Fixed16 bão hòa ở ±2 để thương không tràn 16.16 khi delta rất nhỏ;
+    // sweptAABB cắt mọi thời điểm về [0, 1] nên kết quả không đổi
+    inline float slabTime(float num, float delta) { return num / delta; }
+    inline Fixed16 slabTime(Fixed16 num, Fixed16 delta) {
+        std::int64_t n = num.rawValue(), d = delta.rawValue();
+        if (d < 0) { n = -n; d = -d; }
+        if (n >= 2 * d) return Fixed16(2);
+        if (n <= -2 * d) return Fixed16(-2);
+        return Fixed16::fromRaw(static_cast<std::int32_t>(n * Fixed16::ONE / d));
+    }
+
+    // Hộp A (ax, ay, aw, ah) đi thêm (dx, dy) trong tick, hộp B đứng yên. Trả về true nếu A chạm B
+    // trên đoạn đường đó và ghi thời điểm chạm đầu tiên vào outT (0 = đầu tick, 1 = cuối tick).
+    // Chỉ chạm mép (diện tích giao bằng 0) không tính, giống SDL_HasIntersection.
+    template <typename T>
+    bool sweptAABB(T ax, T ay, T aw, T ah, T dx, T dy, const SDL_Rect& b, T& outT) {
+        T tEnter = T(0), tExit = T(1);
+        // Thu hẹp [tEnter, tExit] theo một trục: A giao B khi start nằm trong (lo, hi)
+        auto slab = [&](T start, T size, T delta, T bMin, T bSize) -> bool {
+            T lo = bMin - size, hi = bMin + bSize;
+            if (delta == T(0)) return start > lo && start < hi;
+            T t0 = slabTime(lo - start, delta), t1 = slabTime(hi - start, delta);
+            if (t0 > t1) std::swap(t0, t1);
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+            return tEnter < tExit;
+        };
+        if (!slab(ax, aw, dx, T(b.x), T(b.w))) return false;
+        if (!slab(ay, ah, dy, T(b.y), T(b.h))) return false;
+        outT = tEnter;
+        return true;
+    }
+
+    // Hộp nguyên bao cả đường quét của A, dùng làm vùng truy vấn broadphase
+    template <typename T>
+    SDL_Rect sweptBounds(T ax, T ay, T aw, T ah, T dx, T dy) {
+        int x0 = floorInt(std::min(ax, ax + dx));
+        int y0 = floorInt(std::min(ay, ay + dy));
+        int x1 = ceilInt(std::max(ax, ax + dx) + aw);
+        int y1 = ceilInt(std::max(ay, ay + dy) + ah);
+        return SDL_Rect{ x0, y0, x1 - x0, y1 - y0 };
+    }
+
+    // Hộp nhỏ nhất chứa cả a và b
+    inline SDL_Rect unionRect(const SDL_Rect& a, const SDL_Rect& b) {
+        int x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+        int x1 = std::max(a.x + a.w, b.x + b.w), y1 = std::max(a.y + a.h, b.y + b.h);
+        return SDL_Rect{ x0, y0, x1 - x0, y1 - y0 };
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "math.hpp"
+#include "TileMap.hpp"
+#include "Fixed.hpp"
+#include "SpriteRegion.hpp"
+
+struct RenderSnapshot; // Forward declaration
+
+enum class EnemyState : std::uint8_t { ALIVE, DYING, DEAD };
+
+// Toàn bộ lính của một màn, lưu dạng structure-of-arrays.
+// - Mảng "nóng" (vị trí, vận tốc, cờ, timer) được update() đọc/ghi mỗi tick.
+// - Sprite sheet, kích thước frame, hitbox và các hằng số dùng chung cho cả loại (trước đây mỗi
+//   Enemy giữ một bản copy); isVisible chỉ render đọc nên để ở bảng phụ riêng.
+// Lính DEAD bị xóa bằng swap-remove trong removeDead(), nên chỉ số i không ổn định qua các frame.
+class EnemyPool {
+public:
+    // --- Constants ---
+    static constexpr float ANIM_SPEED = 0.15f;
+    static constexpr int NUM_FRAMES_WALK = 6;
+    static constexpr float DYING_DURATION = 0.6f;
+    static constexpr float BLINK_INTERVAL = 0.1f;
+    static constexpr float MOVE_SPEED = 50.0f;
+    static constexpr float GRAVITY = 980.0f;
+    static constexpr float MAX_FALL_SPEED = 600.0f;
+    static constexpr int DEFAULT_FRAME_W = 40; // Kích thước sprite lính khi không có texture (headless)
+    static constexpr int DEFAULT_FRAME_H = 72;
+
+    explicit EnemyPool(const SpriteSheet& p_sheet = SpriteSheet()); // NUM_FRAMES_WALK cột
+
+    std::size_t spawn(vector2d p_pos); // Lính mới đi sang trái
+    // Chỉ lính có isActive() trong [activeMinX, activeMaxX] được update, lính khác đứng yên
+    void update(float dt, const TileMap& map,
+                float activeMinX = std::numeric_limits<float>::lowest(), float activeMaxX = std::numeric_limits<float>::max());
+    void removeDead();
+    void clear();
+    void reserve(std::size_t n);
+
+    std::size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+
+    SDL_Rect getWorldHitbox(std::size_t i) const {
+        return SDL_Rect{ phys::roundToInt(posX[i] + hitbox.x), phys::roundToInt(posY[i] + hitbox.y), hitbox.w, hitbox.h };
+    }
+    vector2d getPos(std::size_t i) const { return vector2d{phys::toFloat(posX[i]), phys::toFloat(posY[i])}; }
+    EnemyState getState(std::size_t i) const { return state[i]; }
+    bool isAlive(std::size_t i) const { return state[i] == EnemyState::ALIVE; }
+    bool isDead(std::size_t i) const { return state[i] == EnemyState::DEAD; }
+    bool isActive(std::size_t i, float minX, float maxX) const { // Sprite chạm đoạn [minX, maxX]
+        float x = phys::toFloat(posX[i]);
+        return x + frameWidth >= minX && x <= maxX;
+    }
+    void takeHit(std::size_t i);
+
+    // Định nghĩa trong render.cpp. Ghi lính chạm đoạn x [minX, maxX] vào snapshot
+    void collect(RenderSnapshot& out, float minX, float maxX) const;
+
+private:
+    // --- Cold: dùng chung cho mọi lính ---
+    SpriteSheet sheet;
+    int frameWidth, frameHeight;
+    SDL_Rect hitbox; // Tương đối so với pos
+
+    // --- Hot ---
+    std::vector<phys::Real> posX, posY;
+    std::vector<phys::Real> velocityY;
+    std::vector<phys::Real> animTimer;
+    std::vector<phys::Real> dyingTimer;
+    std::vector<std::uint8_t> animFrame;
+    std::vector<EnemyState> state;
+    std::vector<std::uint8_t> onGround;
+    std::vector<std::uint8_t> movingRight;
+
+    // --- Cold: từng lính, chỉ render dùng ---
+    std::vector<std::uint8_t> visible;
+    std::vector<phys::Real> prevX, prevY; // Vị trí đầu tick gần nhất
+
+    void updateAlive(std::size_t i, phys::Real dt, const TileMap& map);
+    void swapRemove(std::size_t i);
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+// Số thực dấu phẩy tĩnh 16.16 trên int32: phép cộng/trừ/so sánh là phép toán số nguyên,
+// nhân/chia qua int64. Kết quả giống hệt nhau trên mọi compiler và cờ tối ưu (kể cả -ffast-math),
+// dùng cho chế độ mô phỏng tất định (CONTRA_FIXED_POINT). Phạm vi [-32768, 32768), đủ cho toạ độ
+// thế giới của màn chơi (vài nghìn pixel) nhưng không đủ cho bình phương khoảng cách: dùng phys::withinRadius.
+// Map rộng hơn bị TileMap::fitsPhysicsRange() từ chối từ đầu; assert bắt phần còn lại ở bản Debug.
+class Fixed16 {
+public:
+    static constexpr int FRAC_BITS = 16;
+    static constexpr std::int32_t ONE = 1 << FRAC_BITS;
+    static constexpr int INT_LIMIT = 1 << (31 - FRAC_BITS); // Phần nguyên nằm trong [-INT_LIMIT, INT_LIMIT)
+
+    constexpr Fixed16() : raw(0) {}
+    // Số nguyên đổi chính xác, cho phép ngầm định
+    constexpr Fixed16(int v) : raw(static_cast<std::int32_t>(static_cast<std::int64_t>(v) * ONE)) {
+        assert(v >= -INT_LIMIT && v < INT_LIMIT && "Fixed16: integer out of 16.16 range");
+    }
+
+    static constexpr Fixed16 fromRaw(std::int32_t r) { Fixed16 f; f.raw = r; return f; }
+    // Làm tròn tới bước 1/65536 gần nhất. Ngoài phạm vi thì bão hoà về giá trị lớn/nhỏ nhất
+    // (ép float ngoài phạm vi sang int32 là UB), ở bản Debug thì assert.
+    static constexpr Fixed16 fromFloat(float v) {
+        float scaled = v * ONE + (v >= 0.0f ? 0.5f : -0.5f);
+        assert(scaled >= -2147483648.0f && scaled < 2147483648.0f && "Fixed16: float out of 16.16 range");
+        if (!(scaled < 2147483648.0f)) return fromRaw(INT32_MAX);
+        if (scaled < -2147483648.0f) return fromRaw(INT32_MIN);
+        return fromRaw(static_cast<std::int32_t>(scaled));
+    }
+
+    constexpr std::int32_t rawValue() const { return raw; }
+    constexpr float toFloat() const { return static_cast<float>(raw) / ONE; }
+    constexpr int floorToInt() const { return raw >> FRAC_BITS; } // Dịch phải số học = làm tròn xuống
+    constexpr int roundToInt() const { return (raw + (ONE >> 1)) >> FRAC_BITS; } // .5 làm tròn lên
+
+    constexpr Fixed16 operator-() const { return fromRaw(-raw); }
+    constexpr Fixed16 operator+(Fixed16 o) const { return fromRaw(raw + o.raw); }
+    constexpr Fixed16 operator-(Fixed16 o) const { return fromRaw(raw - o.raw); }
+    constexpr Fixed16 operator*(Fixed16 o) const {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(raw) * o.raw) >> FRAC_BITS));
+    }
+    constexpr Fixed16 operator/(Fixed16 o) const {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(raw) * ONE) / o.raw));
+    }
+    constexpr Fixed16 operator*(int v) const { return fromRaw(raw * v); }
+    constexpr Fixed16 operator/(int v) const { return fromRaw(raw / v); }
+
+    Fixed16& operator+=(Fixed16 o) { raw += o.raw; return *this; }
+    Fixed16& operator-=(Fixed16 o) { raw -= o.raw; return *this; }
+    Fixed16& operator*=(Fixed16 o) { return *this = *this * o; }
+
+    constexpr bool operator==(Fixed16 o) const { return raw == o.raw; }
+    constexpr bool operator!=(Fixed16 o) const { return raw != o.raw; }
+    constexpr bool operator<(Fixed16 o) const { return raw < o.raw; }
+    constexpr bool operator<=(Fixed16 o) const { return raw <= o.raw; }
+    constexpr bool operator>(Fixed16 o) const { return raw > o.raw; }
+    constexpr bool operator>=(Fixed16 o) const { return raw >= o.raw; }
+
+private:
+    std::int32_t raw;
+};
+
+// Kiểu số của vật lý entity (player, pool đạn, lính, turret). Mặc định là float; cấu hình CMake
+// -DCONTRA_FIXED_POINT=ON đổi sang Fixed16. Code vật lý chỉ dùng các hàm dưới đây để đổi kiểu,
+// nên biên dịch được với cả hai và bản float giữ nguyên từng phép toán như trước.
+namespace phys
+{
+#if defined(CONTRA_FIXED_POINT)
+    using Real = Fixed16;
+    constexpr Real real(float v) { return Fixed16::fromFloat(v); }
+    constexpr float toFloat(Real v) { return v.toFloat(); }
+    constexpr int floorToInt(Real v) { return v.floorToInt(); }
+    constexpr int roundToInt(Real v) { return v.roundToInt(); }
+    constexpr Real abs(Real v) { return v < Real() ? -v : v; }
+    constexpr Real copysign(Real mag, Real sign) { return (sign < Real()) != (mag < Real()) ? -mag : mag; }
+    // dx² + dy² <= r², tính trên int64 vì bình phương vượt phạm vi 16.16
+    inline bool withinRadius(Real dx, Real dy, Real r) {
+        std::int64_t x = dx.rawValue(), y = dy.rawValue(), rr = r.rawValue();
+        if (x > rr || -x > rr || y > rr || -y > rr) return false;
+        return x * x + y * y <= rr * rr;
+    }
+    // Thế giới rộng extentPx pixel có nằm trọn trong phạm vi của Real không
+    constexpr bool fitsRange(std::int64_t extentPx) { return extentPx < Fixed16::INT_LIMIT; }
+#else
+    using Real = float;
+    constexpr Real real(float v) { return v; }
+    constexpr float toFloat(Real v) { return v; }
+    inline int floorToInt(Real v) { return static_cast<int>(std::floor(v)); }
+    inline int roundToInt(Real v) { return static_cast<int>(std::round(v)); }
+    inline Real abs(Real v) { return std::abs(v); }
+    inline Real copysign(Real mag, Real sign) { return std::copysign(mag, sign); }
+    inline bool withinRadius(Real dx, Real dy, Real r) { return dx * dx + dy * dy <= r * r; }
+    constexpr bool fitsRange(std::int64_t) { return true; }
+#endif
+
+    // Vị trí / vận tốc 2D của vật lý entity (Player); vector2d chỉ dùng ở biên với render và input
+    struct Vec2 { Real x = Real(), y = Real(); };
+}
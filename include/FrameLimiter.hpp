@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Giữ nhịp frame khi không bật vsync. Hạn của từng frame tính trên SDL_GetPerformanceCounter:
+// ngủ bằng SDL_Delay tới trước hạn SPIN_SECONDS (SDL_Delay chỉ chính xác vài ms, tùy scheduler),
+// phần còn lại quay vòng trên bộ đếm. Frame trễ ít thì frame sau bù lại để giữ nhịp đều;
+// trễ hơn cả một chu kỳ thì bắt nhịp lại từ thời điểm hiện tại thay vì chạy dồn.
+class FrameLimiter {
+public:
+    static constexpr double SPIN_SECONDS = 0.002;
+
+    explicit FrameLimiter(double p_targetFps);
+
+    void setTargetFps(double fps); // <= 0: không giới hạn (vsync tự chặn ở SDL_RenderPresent)
+    double getTargetFps() const { return targetFps; }
+    void wait();                   // Gọi một lần mỗi frame, sau display()
+
+private:
+    double targetFps;
+    Uint64 frequency;
+    Uint64 period;   // Số tick bộ đếm của một frame, 0 = không giới hạn
+    Uint64 deadline; // Hạn của frame hiện tại, 0 = chưa có frame nào
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Chế độ mô phỏng headless: chạy thân vòng lặp fixed-step của World liên tục,
+// không cửa sổ, không render, không SDL_Delay giới hạn frame.
+struct HeadlessOptions {
+    long ticks = 100000;      // Số tick cần chạy
+    float timeStep = 0.01f;   // Bằng timeStep của game (World::timeStepForRate(World::DEFAULT_TICK_RATE))
+    bool sweptCollision = true; // false: chỉ dùng kiểm tra va chạm rời rạc cuối tick
+    bool activityRegion = true; // false: update mọi entity của màn mỗi tick (World::activityRegion)
+    int screenWidth = 1024;   // Dùng cho camera follow (camera ảnh hưởng tới respawn và giới hạn player)
+    bool autoPlay = true;     // Giả lập giữ phím phải + F để player chạy và bắn liên tục
+    bool quiet = true;        // Tắt log std::cout của entity (player hit/respawn...) trong lúc đo
+};
+
+struct HeadlessStats {
+    long ticks = 0;
+    double seconds = 0.0;
+    double simSeconds = 0.0;  // Thời gian trong game đã mô phỏng (ticks × timeStep)
+    int restarts = 0;         // Số lần reset màn do thắng/thua
+    int lastScore = 0;
+    long maxPlayerBullets = 0;
+    long maxEnemyBullets = 0;
+    std::uint64_t stateHash = 0; // FNV-1a trên trạng thái cuối (player, lính, turret, đạn), so sánh giữa các lần chạy
+
+    double ticksPerSecond() const { return seconds > 0.0 ? ticks / seconds : 0.0; }
+    double nsPerTick() const { return ticks > 0 ? seconds * 1e9 / ticks : 0.0; }
+};
+
+HeadlessStats runHeadless(const HeadlessOptions& options);
+void printHeadlessStats(const HeadlessStats& stats);
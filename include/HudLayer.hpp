@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include "SpriteBatch.hpp"
+#include "SpriteRegion.hpp"
+#include "TextRenderer.hpp"
+
+// HUD (điểm, huân chương mạng) và lớp phủ PAUSED / WIN / GAME OVER, vẽ sẵn vào một texture render-target
+// kích thước màn hình. update() chỉ đánh dấu cần vẽ lại khi điểm, số mạng hoặc lớp phủ đổi; mỗi frame
+// render() vẽ cả HUD bằng một quad.
+// Texture giữ màu đã nhân alpha (vẽ BLEND lên nền trong suốt cho ra đúng như vậy) nên được ghép lên
+// màn hình bằng blend mode tùy biến ONE / ONE_MINUS_SRC_ALPHA. Renderer không hỗ trợ blend tùy biến
+// (renderer phần mềm) thì dùng BLEND: lớp phủ màu hơi tối hơn.
+class HudLayer {
+public:
+    enum class Overlay : std::uint8_t { NONE, PAUSED, WON, GAME_OVER };
+
+    // --- Layout ---
+    static constexpr int SCORE_X = 10, SCORE_Y = 10;
+    static constexpr int MEDAL_RENDER_WIDTH = 20, MEDAL_RENDER_HEIGHT = 40;
+    static constexpr int MEDAL_SPACING = 5, MEDAL_TOP_MARGIN = 10, MEDAL_RIGHT_MARGIN = 10;
+
+    // Không sở hữu các TextRenderer; chúng phải sống lâu hơn HudLayer
+    HudLayer(SDL_Renderer* p_renderer, int p_width, int p_height,
+             TextRenderer* p_uiText, TextRenderer* p_titleText, const SpriteRegion& p_medal);
+    ~HudLayer();
+    HudLayer(const HudLayer&) = delete;
+    HudLayer& operator=(const HudLayer&) = delete;
+
+    void update(int score, int lives, Overlay overlay);
+    void markDirty() { dirty = true; } // Renderer mất nội dung render-target (SDL_RENDER_TARGETS_RESET)
+    void render();
+    int bakeCount() const { return bakes; }
+
+private:
+    SDL_Renderer* renderer;
+    int width, height;
+    TextRenderer* uiText;
+    TextRenderer* titleText;
+    SpriteRegion medal;
+    SpriteBatch batch;
+    SDL_Texture* texture; // nullptr: tạo target thất bại, vẽ thẳng mỗi frame
+    SDL_BlendMode compositeBlend;
+
+    int score, lives;
+    Overlay overlay;
+    bool dirty;
+    int bakes;
+
+    void drawContents();
+    void drawResultText(const char* title, SDL_Color color);
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+// Định dạng archive tài nguyên do contra_pack ghi và AssetArchive map thẳng vào bộ nhớ. Little-endian,
+// mọi offset tính từ đầu file:
+//   [Header][khối dữ liệu của từng entry, căn DATA_ALIGNMENT byte][bảng tên][bảng Entry sắp theo tên]
+// Ảnh lưu pixel đã giải mã (IMAGE_FORMAT, các hàng liền nhau), âm thanh lưu PCM đã chuyển sang đúng định dạng
+// của Mix_OpenAudio, font và nhạc nền (stream) lưu nguyên file.
+namespace pack {
+    constexpr char MAGIC[8] = { 'C', 'T', 'R', 'A', 'P', 'A', 'K', '\0' };
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint64_t DATA_ALIGNMENT = 64;
+
+    constexpr std::uint32_t IMAGE_FORMAT = SDL_PIXELFORMAT_RGBA32; // Cùng định dạng AssetLoader/TextureAtlas dùng
+    // Main mở SDL_mixer với đúng định dạng này, nên Mix_Chunk dùng thẳng PCM trong archive
+    constexpr int AUDIO_FREQUENCY = 44100;
+    constexpr int AUDIO_CHANNELS = 2;
+    constexpr std::uint16_t AUDIO_FORMAT = AUDIO_S16SYS;
+
+    enum class EntryType : std::uint32_t { IMAGE = 1, SOUND = 2, BLOB = 3 };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint64_t namesOffset; // Tên (đường dẫn như game dùng, vd. "res/gfx/Enemy.png") nối liền nhau
+        std::uint64_t indexOffset; // entryCount Entry
+    };
+
+    struct Entry {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint32_t nameOffset; // Tính từ namesOffset
+        std::uint32_t nameLength;
+        EntryType type;
+        std::uint32_t format;     // IMAGE: SDL_PixelFormatEnum, SOUND: SDL_AudioFormat
+        std::int32_t width;       // IMAGE: bề rộng (pitch = width * 4), SOUND: tần số
+        std::int32_t height;      // IMAGE: chiều cao, SOUND: số kênh
+    };
+
+    static_assert(sizeof(Header) == 32, "pack::Header layout is part of the file format");
+    static_assert(sizeof(Entry) == 40, "pack::Entry layout is part of the file format");
+}
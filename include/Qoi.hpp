@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Định dạng ảnh QOI (https://qoiformat.org): nén không mất dữ liệu, giải mã một lượt không cần zlib nên nhanh
+// hơn PNG nhiều lần với ảnh lớn (ảnh nền màn chơi, ảnh menu). contra_qoi tạo file .qoi cạnh ảnh gốc; lúc load
+// loadPreferred() dùng file .qoi nếu có và không cũ hơn ảnh gốc, không thì quay về IMG_Load.
+namespace qoi {
+    constexpr std::size_t HEADER_SIZE = 14;
+    constexpr std::size_t PADDING_SIZE = 8;
+    constexpr std::uint64_t MAX_PIXELS = 400000000; // Giới hạn của đặc tả, chặn header hỏng xin bộ nhớ quá lớn
+
+    // Giải mã thẳng vào surface có format cho trước, không qua bước đổi định dạng. Hỗ trợ các định dạng
+    // 8888 (ARGB, RGBA, ABGR, BGRA); định dạng khác thì nullptr. Lỗi thì nullptr, chi tiết ở SDL_GetError().
+    SDL_Surface* decode(const void* data, std::size_t size, Uint32 format);
+    SDL_Surface* load(const std::string& path, Uint32 format);
+    // Nén surface (định dạng bất kỳ) thành file QOI trong out. false nếu lỗi.
+    bool encode(SDL_Surface* surface, std::vector<std::uint8_t>& out);
+
+    bool supportsFormat(Uint32 format);
+    // Định dạng 32-bit có alpha đầu tiên renderer nhận mà decode() ghi được: upload surface định dạng này thì
+    // SDL_CreateTextureFromSurface không phải chuyển pixel. RGBA32 nếu không có.
+    Uint32 preferredFormat(SDL_Renderer* renderer);
+
+    // "res/gfx/a.png" -> "res/gfx/a.qoi"
+    std::string siblingPath(const std::string& path);
+    // Ảnh ở path trong định dạng format: file .qoi cạnh nó nếu có và không cũ hơn nó, không thì IMG_Load rồi đổi định dạng
+    SDL_Surface* loadPreferred(const std::string& path, Uint32 format);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+// Một sprite cần vẽ, toạ độ thế giới của góc trên trái ở đầu và cuối tick (để nội suy)
+struct SpriteInstance {
+    SDL_Texture* texture;
+    SDL_Rect src;
+    float prevX, prevY, x, y;
+    int w, h;
+    std::uint8_t layer; // SpriteBatch::Layer
+    bool flipH;
+};
+
+// Mọi thứ main thread cần để vẽ một tick: sprite của entity, camera, số liệu HUD. Mô phỏng điền bản này
+// sau mỗi tick (collect() của các pool, định nghĩa trong render.cpp), main thread chỉ đọc nên không chạm
+// vào World đang chạy trên thread mô phỏng.
+struct RenderSnapshot {
+    std::vector<SpriteInstance> sprites; // Theo thứ tự vẽ: lính, turret, đạn, player
+    std::vector<SDL_Rect> debugRects;    // Khung hitbox debug (toạ độ thế giới), rỗng trừ khi bật DEBUG_DRAW_HITBOXES
+    float prevCameraX = 0.0f, prevCameraY = 0.0f, cameraX = 0.0f, cameraY = 0.0f;
+    int score = 0, lives = 0;
+    std::uint32_t session = 0; // Lượt chơi đã tạo ra snapshot (SimInput::START)
+    std::uint64_t tick = 0;
+    double tickTime = 0.0;     // Thời điểm tick đến hạn (SimThread::clockSeconds), gốc để tính alpha
+
+    // Giữ capacity của vector để các tick sau không cấp phát lại
+    void clear() { sprites.clear(); debugRects.clear(); }
+};
@@ -4,23 +4,56 @@
 
 #include "entity.hpp"
 #include "math.hpp"
+#include "SpriteBatch.hpp"
+
+struct RenderSnapshot;
 
 class RenderWindow
 {
 public:
-    RenderWindow(const char* p_title, int p_w, int p_h); 
+    RenderWindow(const char* p_title, int p_w, int p_h, bool p_vsync = false); 
     void render(SDL_Texture* p_tex, const SDL_Rect& p_src, const SDL_Rect& p_dst);
     SDL_Texture* loadTexture(const char* p_filePath);   
 
-    int getRefreshRate();
+    int getRefreshRate(); // Tần số quét của chế độ hiện tại trên màn hình chứa cửa sổ, 0 nếu không rõ
+    bool hasVsync() const; // Renderer thật sự chờ vsync ở SDL_RenderPresent
 
     void cleanUp();                                     
     void clear();                                       
     void render(entity& p_entity);                
     void display();   
     SDL_Renderer* getRenderer();                                   
+    int getWidth() const { return width; }   // Kích thước màn hình logic, dùng để bỏ sprite ngoài khung nhìn
+    int getHeight() const { return height; }
+    SpriteBatch& getSpriteBatch() { return spriteBatch; } // Sprite entity/HUD gom lại, vẽ khi flushSprites()
+    void flushSprites();
+    // Gửi sprite của snapshot vào batch ở vị trí nội suy theo alpha, bỏ sprite ngoài màn hình (render.cpp)
+    void drawSnapshot(const RenderSnapshot& snapshot, float cameraX, float cameraY, float alpha);
+
+    // Render target độ phân giải thấp. Toạ độ game vẫn là kích thước logic p_w × p_h: clear() chuyển
+    // sang target và đặt SDL_RenderSetScale cho khớp, display() phóng target lên cửa sổ bằng nearest.
+    // Vùng hiển thị là bội số nguyên lớn nhất của baseW × baseH vừa cửa sổ (căn giữa, viền đen).
+    // baseW/baseH <= 0: vẽ thẳng vào backbuffer như trước.
+    void setInternalResolution(int baseW, int baseH);
+    // Tỉ lệ (0, 1] của độ phân giải gốc cho các frame sau, ResolutionScaler điều chỉnh. Vùng hiển thị không đổi.
+    void setResolutionScale(float scale);
+    SDL_Point getInternalSize() const { return SDL_Point{ targetW, targetH }; } // 0×0 nếu không dùng target
+    // Thời gian CPU từ clear() tới hết display() của frame trước (có vsync thì không tính lúc chờ present)
+    double getLastRenderSeconds() const { return lastRenderSeconds; }
 
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
+    int width, height;
+    SpriteBatch spriteBatch;
+
+    SDL_Texture* lowResTarget; // nullptr: vẽ thẳng vào backbuffer
+    int baseW, baseH;          // Độ phân giải gốc của target, 0 = tắt
+    int targetW, targetH;      // Kích thước hiện tại của lowResTarget
+    float resolutionScale;
+    SDL_Rect outputRect;       // Vùng trên cửa sổ mà target được phóng lên
+    Uint64 frameStart;
+    double lastRenderSeconds;
+
+    void updateTarget();
 };
\ No newline at end of file
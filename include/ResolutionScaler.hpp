@@ -0,0 +1,29 @@
+#pragma once
+
+// Chọn tỉ lệ độ phân giải render (RenderWindow::setResolutionScale) theo thời gian render đo được.
+// Thời gian được làm mượt bằng trung bình trượt. Vượt ngân sách liên tục DOWN_FRAMES frame thì hạ một mức;
+// dưới UP_RATIO ngân sách liên tục UP_FRAMES frame thì nâng một mức. Sau mỗi lần đổi có COOLDOWN_FRAMES
+// frame không đổi tiếp để số đo theo kịp độ phân giải mới.
+class ResolutionScaler {
+public:
+    static constexpr int LEVEL_COUNT = 4;
+    static constexpr float LEVELS[LEVEL_COUNT] = { 1.0f, 0.75f, 0.5f, 0.25f };
+    static constexpr double SMOOTHING = 0.1;  // Trọng số của frame mới trong trung bình trượt
+    static constexpr double UP_RATIO = 0.6;
+    static constexpr int DOWN_FRAMES = 10;
+    static constexpr int UP_FRAMES = 120;
+    static constexpr int COOLDOWN_FRAMES = 30;
+
+    explicit ResolutionScaler(double p_budgetSeconds);
+
+    // Gọi mỗi frame với thời gian render vừa đo, trả về tỉ lệ nên dùng cho frame sau
+    float update(double renderSeconds);
+    float getScale() const { return LEVELS[level]; }
+    double getAverageSeconds() const { return average; }
+
+private:
+    double budget;
+    double average;
+    int level;
+    int framesOver, framesUnder, cooldown;
+};
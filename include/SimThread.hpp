@@ -0,0 +1,106 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "World.hpp"
+#include "player.hpp"
+#include "sfx.hpp"
+#include "RenderSnapshot.hpp"
+#include "TripleBuffer.hpp"
+#include "SpscQueue.hpp"
+
+// Lệnh main thread gửi cho mô phỏng
+struct SimInput {
+    enum class Type : std::uint8_t {
+        START,    // Bắt đầu lượt chơi mới, value = số lượt (ghi vào RenderSnapshot::session)
+        PAUSE,
+        RESUME,
+        KEYS,     // value = mask KEY_* của các phím đang giữ
+        KEY_DOWN  // value = SDL_Keycode vừa nhấn
+    };
+    // Các phím Player::handleInput đọc
+    static constexpr std::uint32_t KEY_LEFT = 1u << 0, KEY_RIGHT = 1u << 1, KEY_UP = 1u << 2, KEY_DOWN = 1u << 3, KEY_SHOOT = 1u << 4;
+
+    Type type;
+    std::int32_t value;
+};
+
+// Sự kiện mô phỏng gửi về main thread
+struct SimEvent {
+    enum class Type : std::uint8_t {
+        SOUND,          // value = SoundEffect, x = vị trí nguồn âm (sfx::NO_POSITION nếu không có), tick = tick phát
+        GAME_OVER,      // value = điểm cuối
+        WON             // value = điểm cuối
+    };
+    Type type;
+    std::int32_t value;
+    float x = 0.0f;
+    std::uint64_t tick = 0;
+};
+
+// Chạy vòng fixed-step của World trên một thread riêng. Hai bên chỉ gặp nhau qua ba kênh không khóa:
+// SimInput (main → mô phỏng) và SimEvent (mô phỏng → main) qua SpscQueue, RenderSnapshot qua TripleBuffer.
+// Mô phỏng publish một snapshot sau mỗi tick; main thread vẽ bản mới nhất, nội suy theo thời gian đã trôi
+// kể từ lúc tick đó đến hạn. Mọi lời gọi SDL (render, âm thanh, bàn phím) vẫn ở main thread: sfx::play
+// trong lúc tick được chuyển thành SimEvent::SOUND.
+// threaded = false: không tạo thread, main thread gọi pump() mỗi frame để chạy các tick đến hạn (cùng
+// đường đi dữ liệu, dùng khi cần debug mô phỏng trên một thread).
+class SimThread {
+public:
+    static constexpr std::size_t INPUT_QUEUE_SIZE = 256;
+    static constexpr std::size_t EVENT_QUEUE_SIZE = 256;
+    static constexpr double MAX_FRAME_SECONDS = 0.25; // Bị treo lâu hơn thì bỏ bớt tick thay vì đuổi theo
+    static constexpr float VIEW_MARGIN = 64.0f;       // Lề quanh khung nhìn khi ghi snapshot, đủ cho một tick di chuyển
+
+    // cameraMaxX: giới hạn phải của camera (bề rộng màn chơi trừ bề rộng màn hình, âm thì camera đứng ở 0)
+    SimThread(World& p_world, Player& p_player, float p_timeStep, int p_screenWidth, float p_cameraMaxX, bool p_threaded);
+    ~SimThread();
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    void start(); // Tạo thread (nếu threaded) và nhận sfx::play
+    void stop();  // Dừng và join thread; World/Player lại thuộc về thread gọi
+    void pump();  // Không thread: xử lý lệnh và chạy các tick đến hạn ngay trên thread gọi
+
+    // --- Main thread ---
+    bool pushInput(const SimInput& input) { return inputs.push(input); } // false nếu hàng đợi đầy
+    bool pollEvent(SimEvent& out) { return events.pop(out); }
+    const RenderSnapshot& latestSnapshot() { snapshots.acquire(); return snapshots.readBuffer(); }
+    bool isThreaded() const { return threaded; }
+
+    // Đồng hồ đơn điệu dùng chung cho cả hai thread (RenderSnapshot::tickTime)
+    static double clockSeconds();
+
+private:
+    World& world;
+    Player& player;
+    float timeStep;
+    int screenWidth;
+    float cameraMaxX;
+    bool threaded;
+
+    std::thread thread;
+    std::atomic<bool> quit;
+    SpscQueue<SimInput, INPUT_QUEUE_SIZE> inputs;
+    SpscQueue<SimEvent, EVENT_QUEUE_SIZE> events;
+    TripleBuffer<RenderSnapshot> snapshots;
+
+    // --- Chỉ thread mô phỏng chạm ---
+    Uint8 keyStates[SDL_NUM_SCANCODES]; // Dựng lại từ mask KEYS cho Player::handleInput
+    bool running, paused;
+    std::uint32_t session;
+    std::uint64_t ticks;
+    double lastTime;
+    double accumulator;
+
+    static SimThread* soundTarget; // Thể hiện đang nhận sfx::play
+    static void queueSound(SoundEffect effect, float x);
+
+    void run();
+    void drainInputs();
+    void advance(double now);
+    bool tick(double dueTime); // true nếu lượt chơi kết thúc ở tick này
+    void publish(double tickTime);
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "AabbBatch.hpp"
+
+// Spatial hash dạng lưới đều (ô vuông cellSize, thường là LOGICAL_TILE_WIDTH) cho broadphase.
+// Mỗi tick: clear() -> insert() từng hitbox -> build() -> query().
+// build() xếp id theo bucket kiểu counting sort vào mảng liên tục; sau lần đầu các vector
+// đã đủ lớn nên không cấp phát lại. Số bucket tỉ lệ với số phần tử, không phụ thuộc độ rộng map.
+//
+// query() gọi visit(id) cho mọi phần tử nằm trong các ô chạm vào rect. Một id có thể được
+// gọi nhiều lần (phần tử trải trên nhiều ô, hoặc trùng bucket) và có thể không giao thật:
+// người gọi tự kiểm tra SDL_HasIntersection. queryHits() chỉ gọi visit(id) cho phần tử có hộp
+// giao rect: hộp được xếp cùng thứ tự với ids nên mỗi bucket chạy thẳng kernel aabb theo lô.
+class SpatialHash {
+public:
+    explicit SpatialHash(int p_cellSize);
+
+    void clear();
+    void insert(int id, const SDL_Rect& rect);
+    void build();
+
+    template <typename Visit>
+    void query(const SDL_Rect& rect, Visit&& visit) const {
+        if (ids.empty() || rect.w <= 0 || rect.h <= 0) return;
+        int cx0 = cellCoord(rect.x), cx1 = cellCoord(rect.x + rect.w - 1);
+        int cy0 = cellCoord(rect.y), cy1 = cellCoord(rect.y + rect.h - 1);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                std::uint32_t b = bucketOf(cx, cy);
+                for (int k = bucketStart[b]; k < bucketStart[b + 1]; ++k) visit(ids[k]);
+            }
+        }
+    }
+
+    template <typename Visit>
+    void queryHits(const SDL_Rect& rect, Visit&& visit) const {
+        if (ids.empty() || rect.w <= 0 || rect.h <= 0) return;
+        const aabb::Box q = aabb::fromRect(rect);
+        int cx0 = cellCoord(rect.x), cx1 = cellCoord(rect.x + rect.w - 1);
+        int cy0 = cellCoord(rect.y), cy1 = cellCoord(rect.y + rect.h - 1);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                std::uint32_t b = bucketOf(cx, cy);
+                for (int k0 = bucketStart[b]; k0 < bucketStart[b + 1]; k0 += 32) {
+                    std::uint32_t mask;
+                    std::size_t n = static_cast<std::size_t>(std::min(32, bucketStart[b + 1] - k0));
+                    if (boxes.intersect(q, static_cast<std::size_t>(k0), n, &mask) == 0) continue;
+                    for (; mask; mask &= mask - 1) visit(ids[k0 + aabb::lowestBit(mask)]);
+                }
+            }
+        }
+    }
+
+    int getCellSize() const { return cellSize; }
+
+private:
+    struct Entry {
+        int id;
+        int cx, cy;
+        int rect; // Chỉ số trong rects
+    };
+
+    int cellSize;
+    std::uint32_t bucketMask;
+    std::vector<Entry> entries;       // Một entry cho mỗi ô mà phần tử chạm vào
+    std::vector<int> bucketStart;     // Kích thước bucketCount + 1
+    std::vector<int> cursor;          // Vị trí ghi tiếp theo của mỗi bucket khi build
+    std::vector<int> ids;             // id xếp theo bucket
+    std::vector<SDL_Rect> rects;      // Hitbox theo thứ tự insert
+    AabbBatch boxes;                  // Hitbox xếp theo bucket, song song với ids
+
+    int cellCoord(int v) const { return v >= 0 ? v / cellSize : -((-v - 1) / cellSize) - 1; } // floor(v / cellSize)
+    std::uint32_t bucketOf(int cx, int cy) const {
+        return ((static_cast<std::uint32_t>(cx) * 73856093u) ^ (static_cast<std::uint32_t>(cy) * 19349663u)) & bucketMask;
+    }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Gom các sprite của một frame thành quad trong một vertex buffer, rồi vẽ bằng SDL_RenderGeometry
+// thay cho mỗi sprite một SDL_RenderCopy/RenderCopyEx. flush() sắp xếp quad theo (layer, texture,
+// thứ tự gọi draw) và gửi mỗi dãy quad liên tiếp cùng texture bằng một lệnh: sprite trong trang
+// atlas dùng chung texture nên cả lượt vẽ entity thường chỉ tốn một draw call.
+// Lật ngang được làm bằng cách đổi toạ độ UV, không cần RenderCopyEx.
+class SpriteBatch {
+public:
+    // Layer nhỏ vẽ trước (nằm dưới). Cùng layer thì giữ thứ tự gọi draw() trong mỗi texture.
+    enum Layer : std::uint8_t {
+        LAYER_ENEMIES = 0,
+        LAYER_TURRETS,
+        LAYER_BULLETS,
+        LAYER_PLAYER,
+        LAYER_HUD
+    };
+
+    // color nhân với màu texture (mặc định trắng = giữ nguyên), dùng để tô chữ từ atlas glyph trắng
+    void draw(SDL_Texture* tex, const SDL_Rect& src, const SDL_Rect& dst, bool flipH, std::uint8_t layer,
+              SDL_Color color = SDL_Color{ 255, 255, 255, 255 });
+    // Vẽ hết quad đã gom rồi xóa batch. Gọi trước khi vẽ trực tiếp thứ gì phải nằm trên các sprite này.
+    void flush(SDL_Renderer* renderer);
+
+    std::size_t pendingCount() const { return quads.size(); }
+    int lastDrawCalls() const { return drawCalls; } // Số lệnh RenderGeometry của lần flush gần nhất
+
+private:
+    struct Quad {
+        std::uint64_t key; // layer | chỉ số texture | thứ tự gọi
+        SDL_Texture* tex;
+        SDL_Rect src, dst;
+        bool flipH;
+        SDL_Color color;
+    };
+    struct TextureInfo {
+        SDL_Texture* tex;
+        float invW, invH;
+    };
+
+    std::vector<Quad> quads;
+    std::vector<TextureInfo> textures; // Texture gặp trong frame, chỉ số theo lần gặp đầu
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;          // 0 1 2  2 3 0 cho từng quad, chỉ mở rộng khi batch lớn hơn
+    int drawCalls = 0;
+
+    std::uint32_t textureIndex(SDL_Texture* tex);
+};
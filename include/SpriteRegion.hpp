@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Handle tới một sprite sheet: texture chứa nó và vùng của sheet trên texture đó. Sheet nằm trong
+// trang atlas thì rect là ô được xếp; texture riêng thì rect là toàn bộ texture. Mô phỏng headless
+// dùng region rỗng (texture = nullptr).
+struct SpriteRegion {
+    SDL_Texture* texture = nullptr;
+    SDL_Rect rect = { 0, 0, 0, 0 };
+
+    explicit operator bool() const { return texture != nullptr; }
+
+    // Source rect trên texture của frame thứ col, các frame w×h xếp thành một hàng ngang từ góc sheet
+    SDL_Rect frame(int col, int w, int h) const { return SDL_Rect{ rect.x + col * w, rect.y, w, h }; }
+    // Đổi source rect tính theo toạ độ trong sheet sang toạ độ trên texture
+    SDL_Rect sub(const SDL_Rect& local) const { return SDL_Rect{ rect.x + local.x, rect.y + local.y, local.w, local.h }; }
+};
+
+// Region phủ cả texture, cho texture load riêng không qua atlas
+inline SpriteRegion wholeTexture(SDL_Texture* tex) {
+    SpriteRegion r;
+    r.texture = tex;
+    if (tex) SDL_QueryTexture(tex, NULL, NULL, &r.rect.w, &r.rect.h);
+    return r;
+}
+
+// Sprite sheet một hàng ngang gồm columns frame bằng nhau. Kích thước frame tính một lần khi sheet được
+// load (AssetManager), các pool/Player dùng lại thay vì tự chia lại trong constructor. Sheet rỗng
+// (headless) có frame 0×0, nơi dùng tự chọn kích thước mặc định.
+struct SpriteSheet {
+    SpriteRegion region;
+    int columns = 1;
+    int frameWidth = 0, frameHeight = 0;
+
+    explicit operator bool() const { return static_cast<bool>(region); }
+    SDL_Rect frame(int col) const { return region.frame(col, frameWidth, frameHeight); }
+
+    static SpriteSheet of(const SpriteRegion& region, int columns) {
+        SpriteSheet s;
+        s.region = region;
+        s.columns = columns > 0 ? columns : 1;
+        s.frameWidth = region.rect.w / s.columns;
+        s.frameHeight = region.rect.h;
+        return s;
+    }
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Hàng đợi vòng kích thước cố định cho đúng một thread đẩy và một thread lấy, không khóa, không cấp phát.
+// CAPACITY phải là lũy thừa của 2; chứa tối đa CAPACITY - 1 phần tử, đầy thì push() trả về false.
+template <typename T, std::size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+    bool push(const T& item) {
+        std::size_t tail = writeIndex.load(std::memory_order_relaxed);
+        std::size_t next = (tail + 1) & MASK;
+        if (next == readIndex.load(std::memory_order_acquire)) return false;
+        items[tail] = item;
+        writeIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire)) return false;
+        out = items[head];
+        readIndex.store((head + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t MASK = CAPACITY - 1;
+
+    T items[CAPACITY];
+    // Hai chỉ số nằm trên hai cache line khác nhau để hai thread không tranh nhau một dòng
+    alignas(64) std::atomic<std::size_t> writeIndex{ 0 };
+    alignas(64) std::atomic<std::size_t> readIndex{ 0 };
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include "SpriteBatch.hpp"
+
+// Vẽ chữ ASCII của một font/cỡ chữ mà không tạo surface/texture mỗi frame.
+// - Chuỗi thay đổi (điểm số, số tile debug): glyph 32..126 được rasterize một lần vào atlas màu trắng,
+//   draw() xếp từng ký tự thành quad trong SpriteBatch, tô màu bằng màu vertex. Không cấp phát.
+// - Chuỗi cố định (menu, PAUSED, GAME OVER...): drawStatic() render cả chuỗi bằng TTF một lần
+//   và giữ texture đến khi hủy TextRenderer.
+// Font pixel kongtext là monospace nên bỏ qua kerning.
+class TextRenderer {
+public:
+    static constexpr int FIRST_GLYPH = 32;
+    static constexpr int LAST_GLYPH = 126;
+
+    TextRenderer(SDL_Renderer* p_renderer, TTF_Font* p_font);
+    ~TextRenderer();
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    bool isLoaded() const { return atlas != nullptr; }
+    int lineHeight() const { return height; }
+    int measure(const char* text) const;
+
+    // Vẽ text với góc trên trái tại (x, y), trả về bề rộng đã vẽ. Ký tự ngoài bảng glyph bị bỏ qua.
+    int draw(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color,
+             std::uint8_t layer = SpriteBatch::LAYER_HUD) const;
+    // Chuỗi cố định theo cặp (text, color): texture được tạo ở lần gọi đầu. Trả về kích thước chuỗi.
+    SDL_Point drawStatic(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color,
+                         std::uint8_t layer = SpriteBatch::LAYER_HUD);
+    SDL_Point staticSize(const char* text, SDL_Color color);
+
+private:
+    struct Glyph {
+        SDL_Rect src; // Trên atlas, w = 0 nếu glyph trống (dấu cách)
+        int advance;
+    };
+    struct StaticText {
+        std::string text;
+        SDL_Color color;
+        SDL_Texture* texture;
+        int w, h;
+    };
+
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    SDL_Texture* atlas;
+    int height;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+    std::vector<StaticText> statics;
+
+    const StaticText* findOrCreateStatic(const char* text, SDL_Color color);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SpriteRegion.hpp"
+
+class AssetLoader;
+
+// Gom các sprite sheet nhỏ vào một vài trang texture lúc khởi động, để các lệnh vẽ entity dùng
+// chung texture (ít đổi state, gộp được draw call). Cách dùng: add() từng file, build() một lần,
+// rồi region(handle) trả về trang và vùng của sheet. Xếp bằng thuật toán skyline bottom-left,
+// ảnh cao xếp trước. Cùng đường dẫn hoặc cùng nội dung pixel thì dùng chung một ô (trừ khi tắt
+// setDeduplicate, để reload() một file không ghi đè sprite của file khác cùng nội dung).
+class TextureAtlas {
+public:
+    static constexpr int PAGE_SIZE = 1024; // Tất cả sprite hiện tại (~0.3 MP) vừa một trang
+    static constexpr int PADDING = 1;      // Pixel trong suốt giữa các ô, tránh lem màu khi lọc tuyến tính
+
+    explicit TextureAtlas(SDL_Renderer* p_renderer, int p_pageSize = PAGE_SIZE);
+    ~TextureAtlas();
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // false: file khác tên luôn có ô riêng dù cùng pixel. Chỉ gọi trước add().
+    void setDeduplicate(bool enabled) { deduplicate = enabled; }
+
+    // Load ảnh vào RAM, trả về handle (>= 0) hoặc -1 nếu lỗi. Chỉ gọi trước build().
+    int add(const std::string& p_filePath);
+    // Nhận quyền sở hữu ảnh đã giải mã sẵn (vd. surface trỏ vào AssetArchive đã map). Chỉ gọi trước build().
+    int add(const std::string& p_filePath, SDL_Surface* p_surface);
+    // Giải mã trên worker của loader, trả về handle ngay. build() lấy kết quả (chờ nếu chưa xong) rồi mới
+    // khử trùng lặp theo pixel; ảnh lỗi cho region rỗng. loader phải sống tới build().
+    int add(const std::string& p_filePath, AssetLoader& p_loader);
+    // Xếp các ảnh đã add vào trang, tạo texture và giải phóng surface. Trả về false nếu upload lỗi.
+    bool build();
+
+    // Ghi đè pixel của một ô đã xếp bằng ảnh mới cùng kích thước (hot reload), nhận quyền sở hữu surface.
+    // Ảnh đổi kích thước phải xếp lại cả trang nên trả về false, giữ ảnh cũ.
+    bool reload(int handle, SDL_Surface* surface);
+
+    SpriteRegion region(int handle) const;
+    int pageCount() const { return static_cast<int>(pages.size()); }
+    int imageCount() const; // Sau khi khử trùng lặp
+
+private:
+    struct Image {
+        std::string path;
+        SDL_Surface* surface; // RGBA32, nullptr sau build()
+        std::uint64_t hash;   // FNV-1a của pixel
+        int page;             // -1: chưa xếp hoặc load lỗi
+        SDL_Rect rect;
+        int job;              // Id trong loader, -1 nếu đã load đồng bộ
+        int alias;            // Ảnh trước đó có cùng pixel (chỉ với add bất đồng bộ), -1 nếu không
+    };
+
+    SDL_Renderer* renderer;
+    int pageSize;
+    bool built;
+    bool deduplicate;
+    std::vector<Image> images;
+    std::vector<SDL_Texture*> pages;
+    AssetLoader* loader; // Nơi lấy ảnh add bất đồng bộ, nullptr nếu không có
+
+    void resolvePending();
+};
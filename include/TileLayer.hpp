@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "TileMap.hpp"
+
+// Vẽ màn chơi trực tiếp từ TileMap (cùng dữ liệu với va chạm) và res/gfx/Tileset.png, thay cho ảnh nền vẽ tay.
+// Map chia thành các chunk CHUNK_COLS × CHUNK_ROWS tile. Mỗi chunk được bake một lần vào một texture render-target:
+// toạ độ nguồn trên tileset của từng TileType được tính sẵn trong constructor, nên lúc bake chỉ còn tra bảng.
+// Mỗi frame chỉ các chunk thấy được được vẽ, mỗi chunk một lệnh. Chunk chỉ bake lại khi bị markDirty()
+// (đổi tile) hoặc khi renderer mất nội dung render-target (SDL_RENDER_TARGETS_RESET).
+class TileLayer {
+public:
+    static constexpr int CHUNK_COLS = 16;
+    static constexpr int CHUNK_ROWS = 7;          // Cả chiều cao màn chơi hiện tại
+    static constexpr int TILESET_TILE_SIZE = 32;  // Ô trên Tileset.png, phóng lên kích thước tile logic khi bake
+
+    TileLayer(SDL_Renderer* p_renderer, SDL_Texture* p_tileset, const TileMap& p_map);
+    ~TileLayer();
+    TileLayer(const TileLayer&) = delete;
+    TileLayer& operator=(const TileLayer&) = delete;
+
+    bool isLoaded() const { return tileset != nullptr && !chunks.empty(); }
+    int chunkCount() const { return static_cast<int>(chunks.size()); }
+    int bakeCount() const { return bakes; } // Tổng số lần bake, để kiểm tra chunk không bị bake lại mỗi frame
+
+    void markDirty(int col, int row);
+    void markAllDirty();
+    void render(float cameraX, float cameraY, int screenWidth, int screenHeight);
+
+private:
+    struct Chunk {
+        SDL_Texture* texture; // Render target, nullptr nếu chưa tạo
+        int col0, row0, cols, rows;
+        bool dirty;
+    };
+
+    SDL_Renderer* renderer;
+    SDL_Texture* tileset;
+    const TileMap& map;
+    int tileWidth, tileHeight;
+    int chunksPerRow;
+    std::vector<Chunk> chunks;
+    SDL_Rect sourceRect[256]; // Theo TileType; w = 0: không có hình trên tileset
+    int bakes;
+
+    bool bake(Chunk& chunk);
+};
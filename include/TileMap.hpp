@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Fixed.hpp"
+
+// --- Tile Types --- (giá trị trong mapData)
+enum TileType : std::uint8_t {
+    TILE_EMPTY = 0,
+    TILE_GRASS = 1,         // Đứng được từ trên xuống, nhấn D để rơi xuyên qua
+    TILE_UNKNOWN_SOLID = 2, // Khối đặc: chặn cả tường và trần
+    TILE_WATER_SURFACE = 3,
+    TILE_TURRET = 4,        // Vị trí đặt turret, bản thân tile là rỗng
+    TILE_ABYSS = 5
+};
+
+// --- Tile Properties --- (bit flag, tra bảng theo TileType)
+enum TileFlag : std::uint8_t {
+    TF_SOLID = 1 << 0,         // Chặn di chuyển ngang và trần
+    TF_STANDABLE = 1 << 1,     // Có mặt trên để đứng
+    TF_ONE_WAY = 1 << 2,       // Platform một chiều (rơi xuyên được)
+    TF_WATER = 1 << 3,
+    TF_ABYSS = 1 << 4,
+    TF_TURRET_SPAWN = 1 << 5
+};
+
+// Map dạng phẳng: một mảng uint8_t liên tục theo hàng (row-major), kèm bảng thuộc tính
+// và bitmask từng hàng (TF_SOLID, TF_STANDABLE) cho truy vấn theo vùng chữ nhật.
+// Toạ độ ngoài map (kể cả âm) luôn là TILE_EMPTY, giống getTileAt cũ của Player/Enemy.
+class TileMap {
+public:
+    TileMap(const std::vector<std::vector<int>>& p_rows, int p_tileWidth, int p_tileHeight);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getTileWidth() const { return tileWidth; }
+    int getTileHeight() const { return tileHeight; }
+    float getWorldWidth() const { return static_cast<float>(cols * tileWidth); }
+    float getWorldHeight() const { return static_cast<float>(rows * tileHeight); }
+    // Chế độ CONTRA_FIXED_POINT: map rộng/cao từ 32768 px trở lên làm tràn toạ độ 16.16 nên bị từ chối
+    bool fitsPhysicsRange() const {
+        return phys::fitsRange(static_cast<std::int64_t>(cols) * tileWidth) && phys::fitsRange(static_cast<std::int64_t>(rows) * tileHeight);
+    }
+
+    // --- Truy vấn theo ô ---
+    std::uint8_t tileAt(int col, int row) const {
+        bool inside = static_cast<unsigned>(col) < static_cast<unsigned>(cols) && static_cast<unsigned>(row) < static_cast<unsigned>(rows);
+        return inside ? tiles[static_cast<std::size_t>(row) * cols + col] : static_cast<std::uint8_t>(TILE_EMPTY);
+    }
+    std::uint8_t flagsAt(int col, int row) const { return FLAGS[tileAt(col, row)]; }
+    bool isSolid(int col, int row) const { return (flagsAt(col, row) & TF_SOLID) != 0; }
+    bool isStandable(int col, int row) const { return (flagsAt(col, row) & TF_STANDABLE) != 0; }
+
+    // --- Truy vấn theo toạ độ thế giới ---
+    int colAt(float worldX) const { return worldX >= 0.0f ? static_cast<int>(worldX / tileWidth) : -1; }
+    int rowAt(float worldY) const { return worldY >= 0.0f ? static_cast<int>(worldY / tileHeight) : -1; }
+    std::uint8_t tileAtWorld(float worldX, float worldY) const { return tileAt(colAt(worldX), rowAt(worldY)); }
+    std::uint8_t flagsAtWorld(float worldX, float worldY) const { return FLAGS[tileAtWorld(worldX, worldY)]; }
+    bool isSolidAtWorld(float worldX, float worldY) const { return (flagsAtWorld(worldX, worldY) & TF_SOLID) != 0; }
+    bool isStandableAtWorld(float worldX, float worldY) const { return (flagsAtWorld(worldX, worldY) & TF_STANDABLE) != 0; }
+    // Như colAt/rowAt nhưng làm tròn xuống cả với số âm (-1 chỉ là cột bên trái cột 0, không phải "ngoài map")
+    int worldCol(float worldX) const;
+    int worldRow(float worldY) const;
+
+    // --- Truy vấn theo toạ độ 16.16 --- (chế độ CONTRA_FIXED_POINT): chỉ dùng số nguyên, phép chia
+    // cho kích thước tile thay bằng nhân với nghịch đảo rồi dịch phải, chính xác trong phạm vi Fixed16
+    int colOfPixel(int px) const { return static_cast<int>((static_cast<std::uint64_t>(px) * colRecip) >> 32); }
+    int rowOfPixel(int py) const { return static_cast<int>((static_cast<std::uint64_t>(py) * rowRecip) >> 32); }
+    int colAt(Fixed16 worldX) const { return worldX.rawValue() >= 0 ? colOfPixel(worldX.floorToInt()) : -1; }
+    int rowAt(Fixed16 worldY) const { return worldY.rawValue() >= 0 ? rowOfPixel(worldY.floorToInt()) : -1; }
+    std::uint8_t tileAtWorld(Fixed16 worldX, Fixed16 worldY) const { return tileAt(colAt(worldX), rowAt(worldY)); }
+    std::uint8_t flagsAtWorld(Fixed16 worldX, Fixed16 worldY) const { return FLAGS[tileAtWorld(worldX, worldY)]; }
+    bool isSolidAtWorld(Fixed16 worldX, Fixed16 worldY) const { return (flagsAtWorld(worldX, worldY) & TF_SOLID) != 0; }
+    bool isStandableAtWorld(Fixed16 worldX, Fixed16 worldY) const { return (flagsAtWorld(worldX, worldY) & TF_STANDABLE) != 0; }
+    // floor(x / tileWidth) = floor(floor(x) / tileWidth); số âm đối xứng qua -1
+    int worldCol(Fixed16 worldX) const { int px = worldX.floorToInt(); return px >= 0 ? colOfPixel(px) : -colOfPixel(-px - 1) - 1; }
+    int worldRow(Fixed16 worldY) const { int py = worldY.floorToInt(); return py >= 0 ? rowOfPixel(py) : -rowOfPixel(-py - 1) - 1; }
+
+    // --- Truy vấn vùng --- (ô [col0..col1] × [row0..row1], tự cắt theo biên map)
+    bool anySolid(int col0, int row0, int col1, int row1) const { return anyInMask(solidMask, col0, row0, col1, row1); }
+    bool anyStandable(int col0, int row0, int col1, int row1) const { return anyInMask(standableMask, col0, row0, col1, row1); }
+    // Vùng thế giới [x0, x1] × [y0, y1] (tính cả biên)
+    bool anySolidInWorldRect(float x0, float y0, float x1, float y1) const {
+        return anySolid(worldCol(x0), worldRow(y0), worldCol(x1), worldRow(y1));
+    }
+    bool anySolidInWorldRect(Fixed16 x0, Fixed16 y0, Fixed16 x1, Fixed16 y1) const {
+        return anySolid(worldCol(x0), worldRow(y0), worldCol(x1), worldRow(y1));
+    }
+
+    // --- Truy vấn quét --- (chống xuyên tile khi một tick đi xa hơn một ô)
+    // Hàng đầu tiên có mặt trên r*tileHeight nằm trong (fromY, toY] và có ô đứng được trong dải x [x0, x1]; -1 nếu không có
+    int firstStandableRowCrossed(float x0, float x1, float fromY, float toY) const;
+    int firstStandableRowCrossed(Fixed16 x0, Fixed16 x1, Fixed16 fromY, Fixed16 toY) const;
+    // Cột đặc đầu tiên có cạnh bị cạnh trước của hộp vượt qua khi đi ngang từ fromX tới toX,
+    // xét trong dải y [y0, y1]; -1 nếu không có
+    int firstSolidColCrossed(float fromX, float toX, float y0, float y1) const;
+    int firstSolidColCrossed(Fixed16 fromX, Fixed16 toX, Fixed16 y0, Fixed16 y1) const;
+
+    static const std::uint8_t FLAGS[256]; // Bảng thuộc tính theo TileType
+
+private:
+    int rows, cols;
+    int tileWidth, tileHeight;
+    std::vector<std::uint8_t> tiles;
+
+    // Mỗi hàng wordsPerRow từ 64 bit, bit c = thuộc tính của cột c
+    std::uint64_t colRecip, rowRecip; // ceil(2^32 / tileWidth), ceil(2^32 / tileHeight)
+    int wordsPerRow;
+    std::vector<std::uint64_t> solidMask;
+    std::vector<std::uint64_t> standableMask;
+
+    // ceil(x / tileWidth), cho cạnh phải của cột khi quét sang trái
+    int worldColCeil(float worldX) const;
+    int worldColCeil(Fixed16 worldX) const { return -worldCol(-worldX); }
+    // Thân chung của hai bản float / Fixed16, định nghĩa trong TileMap.cpp
+    template <typename T> int standableRowCrossed(T x0, T x1, T fromY, T toY) const;
+    template <typename T> int solidColCrossed(T fromX, T toX, T y0, T y1) const;
+    bool anyInMask(const std::vector<std::uint64_t>& mask, int col0, int row0, int col1, int row1) const;
+};
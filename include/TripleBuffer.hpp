@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Bộ đệm ba cho đúng một thread ghi và một thread đọc, không khóa. Thread ghi điền writeBuffer() rồi
+// publish(); thread đọc gọi acquire() để lấy bản publish mới nhất và đọc readBuffer(). Mỗi bên giữ riêng
+// một slot, slot thứ ba nằm ở giữa chờ trao đổi: bên ghi không bao giờ phải chờ bên đọc, bản cũ chưa
+// ai đọc bị ghi đè. Slot được dùng lại nên T giữ được bộ nhớ đã cấp phát (vd. capacity của vector).
+template <typename T>
+class TripleBuffer {
+public:
+    // --- Writer ---
+    T& writeBuffer() { return slots[back]; }
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    // --- Reader ---
+    // true nếu có bản mới kể từ lần acquire trước; false thì readBuffer() giữ bản cũ
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        std::uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return slots[front]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4; // Slot giữa chứa bản publish chưa được đọc
+
+    T slots[3];
+    std::atomic<std::uint8_t> middle{ 1 };
+    std::uint8_t back = 0;  // Chỉ thread ghi chạm
+    std::uint8_t front = 2; // Chỉ thread đọc chạm
+};
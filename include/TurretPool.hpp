@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "math.hpp"
+#include "player.hpp" // Đảm bảo player.hpp đã được include đầy đủ
+#include "BulletPool.hpp"
+#include "Fixed.hpp"
+#include "SpriteRegion.hpp"
+
+struct RenderSnapshot; // Forward declaration
+
+enum class TurretState : std::uint8_t {
+    IDLE, SHOOTING, DESTROYED_ANIM, FULLY_DESTROYED
+};
+
+// Toàn bộ turret của một màn, lưu dạng structure-of-arrays giống EnemyPool:
+// mảng nóng cho timer/hp/state, texture và kích thước frame dùng chung cho cả loại.
+// Turret được giữ theo thứ tự x tăng dần (turret không di chuyển), nên đoạn turret gần camera
+// tìm được bằng tìm kiếm nhị phân. Turret FULLY_DESTROYED bị xóa trong removeDead(), giữ nguyên thứ tự.
+class TurretPool {
+public:
+    // --- Static Constants ---
+    static constexpr float ANIM_SPEED_TURRET_IDLE = 0.2f;
+    static constexpr float ANIM_SPEED_TURRET_SHOOT = 0.1f;
+    static constexpr float ANIM_SPEED_EXPLOSION = 0.1f;
+    static constexpr float TURRET_BULLET_SPEED = 350.0f;
+    static constexpr float TURRET_DIAGONAL_SPEED_COMPONENT = TURRET_BULLET_SPEED / 1.41421356237f;
+    static constexpr int TURRET_BULLET_RENDER_W = 16;
+    static constexpr int TURRET_BULLET_RENDER_H = 16;
+    static constexpr int MAX_HP = 8;
+    static constexpr float SHOOT_COOLDOWN = 1.7f;
+    static constexpr float DETECTION_RADIUS_TILES = 8.0f;
+
+    static constexpr int NUM_FRAMES_TURRET_IDLE = 1;
+    static constexpr int START_FRAME_TURRET_IDLE = 0;
+    static constexpr int NUM_FRAMES_TURRET_SHOOT = 3;
+    static constexpr int START_FRAME_TURRET_SHOOT = 0;
+    static constexpr int NUM_FRAMES_EXPLOSION = 7;
+    // Các animation của turret nằm cùng một hàng, số cột = số frame của animation dài nhất
+    static constexpr int TURRET_SHEET_COLUMNS = NUM_FRAMES_TURRET_SHOOT > NUM_FRAMES_TURRET_IDLE ? NUM_FRAMES_TURRET_SHOOT : NUM_FRAMES_TURRET_IDLE;
+
+    // Kích thước render của turret là một tile. Sheet turret TURRET_SHEET_COLUMNS cột, sheet nổ
+    // NUM_FRAMES_EXPLOSION cột. Âm thanh phát qua sfx::play
+    TurretPool(const SpriteSheet& p_turretSheet, const SpriteSheet& p_explosionSheet, const SpriteRegion& p_bulletSprite,
+               int p_tileWidth, int p_tileHeight);
+
+    std::size_t spawn(vector2d p_pos); // Spawn không theo thứ tự x thì pool được sắp xếp lại ở update() kế tiếp
+    // Chỉ turret trong activeRange(activeMinX, activeMaxX) được update, turret khác giữ nguyên timer
+    void update(float dt, Player* player, BulletPool& enemyBullets,
+                float activeMinX = std::numeric_limits<float>::lowest(), float activeMaxX = std::numeric_limits<float>::max());
+    void removeDead();
+    void clear();
+    void reserve(std::size_t n);
+
+    std::size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+    // Đoạn chỉ số [first, last) của các turret có ô chạm đoạn [minX, maxX]. Chưa sắp xếp thì trả về cả pool.
+    void activeRange(float minX, float maxX, std::size_t& first, std::size_t& last) const;
+
+    // Hitbox trùng với ô render của turret
+    SDL_Rect getWorldHitbox(std::size_t i) const {
+        return SDL_Rect{ phys::roundToInt(posX[i]), phys::roundToInt(posY[i]), renderWidthTurret, renderHeightTurret };
+    }
+    vector2d getPos(std::size_t i) const { return vector2d{phys::toFloat(posX[i]), phys::toFloat(posY[i])}; }
+    TurretState getState(std::size_t i) const { return state[i]; }
+    int getHp(std::size_t i) const { return hp[i]; }
+    bool isFullyDestroyed(std::size_t i) const { return state[i] == TurretState::FULLY_DESTROYED; }
+    void takeDamage(std::size_t i);
+
+    void collect(RenderSnapshot& out, float minX, float maxX) const; // Turret chạm đoạn x [minX, maxX], định nghĩa trong render.cpp
+
+private:
+    // --- Cold: dùng chung cho mọi turret ---
+    SpriteSheet turretSheet;
+    SpriteSheet explosionSheet;
+    SpriteRegion bulletSprite;
+    int renderWidthTurret, renderHeightTurret;             // Kích thước render (bằng tileWidth, tileHeight)
+    int sheetFrameWidthExplosion, sheetFrameHeightExplosion; // Vụ nổ vẽ đúng kích thước frame, không có sheet thì bằng tile
+    phys::Real detectionRadius;
+
+    // --- Hot ---
+    std::vector<phys::Real> posX, posY;
+    std::vector<phys::Real> shootTimer;
+    std::vector<phys::Real> animTimerTurret;
+    std::vector<phys::Real> animTimerExplosion;
+    std::vector<std::uint8_t> animFrameTurret;
+    std::vector<std::uint8_t> animFrameExplosion;
+    std::vector<TurretState> state;
+    std::vector<std::int8_t> hp;
+    bool sortedByX;
+
+    void sortByX();
+    void shootAtPlayer(std::size_t i, phys::Real playerCenterX, phys::Real playerCenterY, BulletPool& enemyBullets, std::uint16_t bulletTexId);
+    void moveEntry(std::size_t from, std::size_t to);
+    void resize(std::size_t n);
+};
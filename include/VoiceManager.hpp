@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL2/SDL_mixer.h>
+#include <cstdint>
+#include <vector>
+#include "sfx.hpp"
+
+// Cách phát của một SoundEffect
+struct VoiceRule {
+    int maxVoices = 2;      // Số kênh tối đa phát cùng lúc hiệu ứng này; hết thì cướp kênh cũ nhất của chính nó
+    int priority = 0;       // Hết kênh thì chỉ cướp kênh có priority thấp hơn hoặc bằng
+    float volume = 1.0f;    // 0..1, nhân với MIX_MAX_VOLUME
+    bool attenuate = true;  // Giảm âm lượng và bỏ hẳn khi nguồn âm ở xa camera (false: luôn nghe rõ, vd. âm của player)
+};
+
+// Quản lý các kênh SDL_mixer thay cho Mix_PlayChannel(-1, ...): mỗi SoundEffect có giới hạn số kênh và độ
+// ưu tiên, nên hàng chục turret bắn cùng lúc không chiếm hết kênh làm mất tiếng nổ hay tiếng player chết.
+// - Cùng hiệu ứng phát nhiều lần trong một tick chỉ chiếm một kênh (lấy âm lượng lớn nhất).
+// - Hết kênh: cướp kênh ưu tiên thấp nhất, trong đó kênh nhỏ tiếng nhất rồi cũ nhất; mọi kênh đều ưu tiên
+//   cao hơn thì bỏ âm mới.
+// - Có vị trí x: pan trái/phải theo vị trí so với giữa khung nhìn; rule attenuate thì nhỏ dần khi ra khỏi
+//   khung nhìn và bỏ hẳn khi cách mép quá CULL_DISTANCE.
+// Chỉ gọi từ main thread. Kênh rảnh được nhận ra bằng Mix_Playing, không dùng Mix_ChannelFinished (chạy
+// trên thread audio).
+class VoiceManager {
+public:
+    static constexpr int DEFAULT_CHANNELS = 16;
+    static constexpr float CULL_DISTANCE = 480.0f; // px ngoài mép khung nhìn mà âm lượng giảm về 0
+    static constexpr float PAN_RANGE = 0.7f;       // Độ lệch tối đa về một bên (1 = tắt hẳn bên kia)
+
+    explicit VoiceManager(int p_channelCount = DEFAULT_CHANNELS); // Gọi sau Mix_OpenAudio
+    ~VoiceManager();
+    VoiceManager(const VoiceManager&) = delete;
+    VoiceManager& operator=(const VoiceManager&) = delete;
+
+    void setRule(SoundEffect effect, const VoiceRule& rule);
+    // Khung nhìn hiện tại (tọa độ màn chơi), gọi mỗi frame trước play()
+    void setListener(float p_cameraX, float p_viewWidth) { cameraX = p_cameraX; viewWidth = p_viewWidth; }
+
+    // tick: tick mô phỏng phát ra âm thanh, để gộp âm trùng. false nếu âm bị bỏ (xa, hết kênh, chunk rỗng).
+    bool play(SoundEffect effect, Mix_Chunk* chunk, float x, std::uint64_t tick);
+    void stopAll();
+
+    int channelCount() const { return static_cast<int>(voices.size()); }
+    int activeCount() const;
+
+private:
+    static constexpr int NUM_EFFECTS = static_cast<int>(SoundEffect::TURRET_EXPLOSION) + 1;
+
+    struct Voice {
+        int effect = -1;           // -1: kênh chưa dùng
+        int priority = 0;
+        float gain = 0.0f;         // Âm lượng đã tính theo khoảng cách, 0..1
+        std::uint64_t started = 0; // Số thứ tự lần phát, để biết kênh nào cũ nhất
+        std::uint64_t tick = 0;
+    };
+
+    std::vector<Voice> voices; // Chỉ số là số kênh SDL_mixer
+    VoiceRule rules[NUM_EFFECTS];
+    float cameraX, viewWidth;
+    std::uint64_t playCount;
+
+    bool isActive(int channel) const { return voices[channel].effect >= 0 && Mix_Playing(channel); }
+    int pickChannel(int effect, int priority, float gain) const; // -1 nếu không có kênh nào được cướp
+    void applyMix(int channel, float gain, float pan) const;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "math.hpp"
+#include "player.hpp"
+#include "BulletPool.hpp"
+#include "EnemyPool.hpp"
+#include "TurretPool.hpp"
+#include "SpatialHash.hpp"
+#include "TileMap.hpp"
+#include "utils.hpp"
+#include "SpriteRegion.hpp"
+
+// Sprite sheet dùng khi spawn entity (vùng trên trang atlas). Mô phỏng headless để tất cả rỗng.
+struct WorldTextures {
+    SpriteSheet enemy;           // EnemyPool::NUM_FRAMES_WALK cột
+    SpriteSheet turret;          // TurretPool::TURRET_SHEET_COLUMNS cột
+    SpriteSheet turretExplosion; // TurretPool::NUM_FRAMES_EXPLOSION cột
+    SpriteRegion turretBullet;
+    SpriteRegion playerBullet;
+};
+
+// Kết quả kiểm tra tiến trình sau mỗi frame, main() dùng để chuyển GameState
+enum class WorldEvent { NONE, PLAYER_OUT_OF_LIVES, PLAYER_REACHED_GOAL };
+
+// Trạng thái mô phỏng của một màn chơi. Chứa phần thân vòng lặp fixed-step
+// trước đây nằm trong main(), không gọi renderer/mixer/ttf nên chạy được headless.
+class World {
+public:
+    // --- Player Config ---
+    static constexpr int PLAYER_STANDARD_FRAME_W = 40;
+    static constexpr int PLAYER_STANDARD_FRAME_H = 78;
+    static constexpr int PLAYER_LYING_FRAME_W = 78;
+    static constexpr int PLAYER_LYING_FRAME_H = 40;
+    static constexpr int PLAYER_BULLET_RENDER_WIDTH = 12;
+    static constexpr int PLAYER_BULLET_RENDER_HEIGHT = 6;
+    static constexpr float PLAYER_START_X = 100.0f;
+    static constexpr float PLAYER_START_Y = 300.0f;
+    static constexpr float PLAYER_RESPAWN_OFFSET_X = 150.0f;
+
+    // --- Bullet Pools ---
+    // Đạn sống tối đa 2 giây: player bắn liên tục chỉ có ~15 viên, mỗi turret tối đa 2 viên
+    static constexpr std::size_t PLAYER_BULLET_CAPACITY = 128;
+    static constexpr std::size_t ENEMY_BULLET_CAPACITY = 256;
+
+    // --- Tick Rate ---
+    // Bước fixed-step của step(). 100 Hz là nhịp gốc; 30/60 Hz rẻ hơn và dựa vào sweptCollision
+    // để đạn không bay xuyên mục tiêu.
+    static constexpr int DEFAULT_TICK_RATE = 100;
+    static constexpr int MIN_TICK_RATE = 30;
+    static constexpr int MAX_TICK_RATE = 240;
+    static float timeStepForRate(int hz) { return 1.0f / utils::clamp(hz, MIN_TICK_RATE, MAX_TICK_RATE); }
+
+    // --- Activity Region ---
+    // Chỉ lính/turret trong [cameraX - ACTIVITY_MARGIN, cameraX + viewWidth + ACTIVITY_MARGIN] được update và
+    // nhận đạn; ngoài vùng này chúng đứng yên, giữ nguyên timer, và chạy tiếp khi camera tới gần.
+    // Lề một màn hình lớn hơn tầm phát hiện của turret (8 tile) nên turret bắn được player luôn đang chạy.
+    static constexpr float ACTIVITY_MARGIN = 1024.0f;
+
+    World(const TileMap& p_map, const WorldTextures& p_textures);
+
+    void reset();                       // Xóa entity cũ, spawn lại lính và turret theo map
+    void step(float dt);                // Một tick fixed-step (thân của while(accumulator >= timeStep))
+    void removeDead();                  // Dọn entity đã chết, gọi một lần mỗi frame
+    WorldEvent checkProgress();         // Hồi sinh player / kiểm tra thắng thua
+    void firePlayerBullets();           // Sinh đạn nếu player đang muốn bắn
+    void followCamera(int screenWidth); // Camera chỉ cuộn sang phải theo player, ghi lại viewWidth
+    void activeBounds(float& minX, float& maxX) const; // Vùng hoạt động theo toạ độ x thế giới
+    // Camera nội suy giữa đầu tick và cuối tick gần nhất, alpha = accumulator / timeStep
+    float renderCameraX(float alpha) const { return utils::lerp(prevCameraX, cameraX, alpha); }
+    float renderCameraY(float alpha) const { return utils::lerp(prevCameraY, cameraY, alpha); }
+
+    // false: map vượt phạm vi toạ độ của phys::Real (chế độ CONTRA_FIXED_POINT), constructor đã báo lỗi
+    bool isMapSupported() const { return map.fitsPhysicsRange(); }
+    const TileMap& getTileMap() const { return map; }
+    int getTileWidth() const { return tileWidth; }
+    int getTileHeight() const { return tileHeight; }
+
+    // Trạng thái công khai để main() render
+    Player* player; // Không sở hữu
+    BulletPool playerBullets;
+    BulletPool enemyBullets;
+    EnemyPool enemies;
+    TurretPool turrets;
+    int score;
+    float cameraX, cameraY;
+    float prevCameraX, prevCameraY; // Camera đầu tick gần nhất, để render nội suy
+    float winConditionX;
+    bool wonFlag;
+    bool sweptCollision; // false: chỉ kiểm tra giao nhau tại vị trí cuối tick như trước
+    bool activityRegion; // false: update mọi lính/turret của màn mỗi tick như trước
+    int viewWidth;       // Bề rộng khung nhìn do followCamera() ghi lại, 0 = chưa biết (cả màn là vùng hoạt động)
+
+private:
+    const TileMap& map;
+    int tileWidth, tileHeight;
+    WorldTextures textures;
+    std::uint16_t playerBulletTexId;
+
+    // Broadphase cho đạn player, dựng lại mỗi tick trong step(). id = chỉ số trong enemies/turrets.
+    SpatialHash enemyGrid, turretGrid;
+    std::vector<SDL_Rect> enemyBoxes, turretBoxes;
+    // Hộp bao đường bay của đạn địch và mask kết quả cho kernel aabb, giữ lại để không cấp phát mỗi tick
+    AabbBatch enemyBulletBounds;
+    std::vector<std::uint32_t> hitMask;
+
+    // Đường bay của một viên đạn trong tick hiện tại
+    struct BulletSweep {
+        SDL_Rect end;    // Hitbox cuối tick (kiểm tra rời rạc)
+        SDL_Rect bounds; // Vùng truy vấn broadphase
+        phys::Real x0, y0, w, h, dx, dy; // Kiểu vật lý: thời điểm chạm tính cùng kiểu với vị trí đạn
+    };
+
+    void buildTargetGrids(float activeMinX, float activeMaxX);
+    BulletSweep sweepOf(const BulletPool& pool, std::size_t i, float dt) const;
+    bool hitTime(const BulletSweep& sweep, const SDL_Rect& target, phys::Real& outT) const;
+};
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <vector>
+
 // Debug Flags
 // Uncomment to enable debug features
 //#define DEBUG_DRAW_GRID     
@@ -15,5 +19,5 @@ namespace Debug {
     void drawTileNumbers(SDL_Renderer* renderer, TTF_Font* font, 
                         float cameraX, float cameraY,
                         const std::vector<std::vector<int>>& mapData,
-                        int tileWidth, int tileHeight);
+                        int tileWidth, int tileHeight, int screenWidth, int screenHeight);
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <vector>
+
+// --- Tile Logic Config ---
+const int LOGICAL_TILE_WIDTH = 96;
+const int LOGICAL_TILE_HEIGHT = 96;
+
+// --- Map Data --- (stage 1, định nghĩa trong map.cpp)
+extern std::vector<std::vector<int>> mapData;
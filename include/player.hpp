@@ -1,16 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <set>
 #include <utility>
 #include <string>
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_mixer.h>
 #include "math.hpp"
+#include "utils.hpp"
+#include "TileMap.hpp"
+#include "Fixed.hpp"
+#include "SpriteRegion.hpp"
 
-class RenderWindow; // Forward declaration
-
-extern Mix_Chunk* gPlayerDeathSound;
+struct RenderSnapshot; // Forward declaration
 
 enum class PlayerState {
     IDLE, RUNNING, JUMPING, FALLING, DROPPING, ENTERING_WATER, SWIMMING, WATER_JUMP,
@@ -20,21 +22,31 @@ enum class PlayerState {
 };
 enum class FacingDirection { LEFT, RIGHT };
 
+// Sprite sheet cho từng nhóm trạng thái của Player. Headless để tất cả rỗng.
+struct PlayerSprites {
+    SpriteSheet run, jump, enterWater, swim;
+    SpriteSheet standAimShootHoriz, runAimShootHoriz;
+    SpriteSheet standAimShootUp;
+    SpriteSheet standAimShootDiagUp, runAimShootDiagUp;
+    SpriteSheet standAimShootDiagDown, runAimShootDiagDown;
+    SpriteSheet lyingDown, lyingAimShoot;
+};
+
 class Player {
 public:
-    // --- Constants (ĐẦY ĐỦ) ---
-    const float GRAVITY = 980.0f; const float MOVE_SPEED = 300.0f;
-    const float JUMP_STRENGTH = 600.0f; const float MAX_FALL_SPEED = 600.0f;
+    // --- Constants (ĐẦY ĐỦ) --- (kiểu vật lý phys::Real, xem Fixed.hpp)
+    const phys::Real GRAVITY = phys::real(980.0f); const phys::Real MOVE_SPEED = phys::real(300.0f);
+    const phys::Real JUMP_STRENGTH = phys::real(600.0f); const phys::Real MAX_FALL_SPEED = phys::real(600.0f);
     // const float WATER_GRAVITY_MULTIPLIER = 0.3f; // BỎ ĐI
     // const float WATER_MAX_SPEED_MULTIPLIER = 0.5f; // BỎ ĐI
-    const float WATER_DRAG_X = 0.85f; const float WATER_JUMP_STRENGTH = 300.0f;
-    const float BULLET_SPEED = 600.0f;
-    const float BULLET_SPEED_DIAG_COMPONENT = BULLET_SPEED * 0.70710678118f;
-    const float ANIM_SPEED = 0.08f; 
-    const float INVULNERABLE_DURATION = 2.0f;
-    const float SHOOT_COOLDOWN = 0.15f;
-    const float DYING_DURATION = 0.8f;    
-    const float BLINK_INTERVAL = 0.1f;    
+    const phys::Real WATER_DRAG_X = phys::real(0.85f); const phys::Real WATER_JUMP_STRENGTH = phys::real(300.0f);
+    const phys::Real BULLET_SPEED = phys::real(600.0f);
+    const phys::Real BULLET_SPEED_DIAG_COMPONENT = phys::real(600.0f * 0.70710678118f);
+    const phys::Real ANIM_SPEED = phys::real(0.08f);
+    const phys::Real INVULNERABLE_DURATION = phys::real(2.0f);
+    const phys::Real SHOOT_COOLDOWN = phys::real(0.15f);
+    const phys::Real DYING_DURATION = phys::real(0.8f);
+    const phys::Real BLINK_INTERVAL = phys::real(0.1f);
     // --- Frame counts (ĐẦY ĐỦ) ---
     const int RUN_FRAMES = 6; const int JUMP_FRAMES = 4;
     const int ENTER_WATER_FRAMES = 1; const int SWIM_FRAMES = 5;
@@ -45,30 +57,28 @@ public:
     const int LYING_DOWN_FRAMES = 1; const int LYING_AIM_SHOOT_FRAMES = 1;
 
     // Constructor 
-    Player(vector2d p_pos,
-           SDL_Texture* p_runTex, int p_runSheetCols, SDL_Texture* p_jumpTex, int p_jumpSheetCols,
-           SDL_Texture* p_enterWaterTex, int p_enterWaterSheetCols, SDL_Texture* p_swimTex, int p_swimSheetCols,
-           SDL_Texture* p_standAimShootUpTex, int p_standAimShootUpSheetCols, SDL_Texture* p_standAimShootDiagUpTex, int p_standAimShootDiagUpSheetCols,
-           SDL_Texture* p_standAimShootDiagDownTex, int p_standAimShootDiagDownSheetCols, SDL_Texture* p_runAimShootDiagUpTex, int p_runAimShootDiagUpSheetCols,
-           SDL_Texture* p_runAimShootDiagDownTex, int p_runAimShootDiagDownSheetCols, SDL_Texture* p_standAimShootHorizTex, int p_standAimShootHorizSheetCols,
-           SDL_Texture* p_runAimShootHorizTex, int p_runAimShootHorizSheetCols, SDL_Texture* p_lyingDownTex, int p_lyingDownSheetCols,
-           SDL_Texture* p_lyingAimShootTex, int p_lyingAimShootSheetCols,
+    Player(vector2d p_pos, const PlayerSprites& p_sprites,
            int p_standardFrameW, int p_standardFrameH, int p_lyingFrameW, int p_lyingFrameH);
+    // Constructor không texture, cho mô phỏng headless (contra_bench)
+    Player(vector2d p_pos, int p_standardFrameW, int p_standardFrameH, int p_lyingFrameW, int p_lyingFrameH);
 
     // Public methods
-    void update(float dt, const std::vector<std::vector<int>>& mapData, int tileWidth, int tileHeight);
-    void render(RenderWindow& window, float cameraX, float cameraY);
+    void update(float dt, const TileMap& map);
+    void collect(RenderSnapshot& out) const; // Ghi sprite hiện tại (kèm vị trí đầu tick) vào snapshot, định nghĩa trong render.cpp
     void handleInput(const Uint8* keyStates);
     void handleKeyDown(SDL_Keycode key);
-    int getTileAt(float worldX, float worldY) const;
+    int getTileAt(phys::Real worldX, phys::Real worldY) const;
     SDL_Rect getWorldHitbox();
-    bool wantsToShoot(vector2d& out_bulletStartPos, vector2d& out_bulletVelocity);
+    bool wantsToShoot(phys::Vec2& out_bulletStartPos, phys::Vec2& out_bulletVelocity);
     void takeHit(bool isFallDamage);
     void respawn(float p_camX, float initialPlayerY_top, float playerStartXOffset);
     void resetPlayerStateForNewGame();
-    vector2d& getPos() { return pos; }
-    const vector2d& getPos() const { return pos; }
-    void setPos(const vector2d& p_pos) { pos = p_pos; }
+    vector2d getPos() const { return vector2d{ phys::toFloat(pos.x), phys::toFloat(pos.y) }; }
+    void setPos(const vector2d& p_pos) { pos = phys::Vec2{ phys::real(p_pos.x), phys::real(p_pos.y) }; prevPos = pos; } // Dịch chuyển tức thời, không nội suy
+    void clampLeft(phys::Real minX) { pos.x = std::max(minX, pos.x); } // Không cho lùi ra sau mép trái camera
+    vector2d getRenderPos(float alpha) const {
+        return vector2d{ utils::lerp(phys::toFloat(prevPos.x), phys::toFloat(pos.x), alpha), utils::lerp(phys::toFloat(prevPos.y), phys::toFloat(pos.y), alpha) };
+    }
     PlayerState getCurrentState() const { return currentState; }
     bool getIsOnGround() const { return isOnGround; }
     bool getIsInWater() const { return isInWaterState; }
@@ -82,72 +92,47 @@ public:
 
 private:
     // Khai báo thành viên theo thứ tự khởi tạo mong muốn
-    vector2d pos;
+    phys::Vec2 pos;
+    phys::Vec2 prevPos; // pos đầu tick gần nhất, để render nội suy
 
-    // --- Textures (ĐẦY ĐỦ) ---
-    SDL_Texture *runTexture;
-    SDL_Texture *jumpTexture;
-    SDL_Texture *enterWaterTexture;
-    SDL_Texture *swimTexture;
-    SDL_Texture *standAimShootHorizTexture;
-    SDL_Texture *runAimShootHorizTexture;
-    SDL_Texture *standAimShootUpTexture;
-    SDL_Texture *standAimShootDiagUpTexture;
-    SDL_Texture *runAimShootDiagUpTexture;
-    SDL_Texture *standAimShootDiagDownTexture;
-    SDL_Texture *runAimShootDiagDownTexture;
-    SDL_Texture *lyingDownTexture;
-    SDL_Texture *lyingAimShootTexture;
-    
-    // --- Sheet Columns (ĐẦY ĐỦ) ---
-    int runSheetColumns;
-    int jumpSheetColumns;
-    int enterWaterSheetColumns;
-    int swimSheetColumns;
-    int standAimShootHorizSheetColumns;
-    int runAimShootHorizSheetColumns;
-    int standAimShootUpSheetColumns;
-    int standAimShootDiagUpSheetColumns;
-    int runAimShootDiagUpSheetColumns;
-    int standAimShootDiagDownSheetColumns;
-    int runAimShootDiagDownSheetColumns;
-    int lyingDownSheetColumns;
-    int lyingAimShootSheetColumns;
+    // --- Sprite sheets: vùng trên trang atlas ---
+    PlayerSprites sprites;
     
     // Frame Dimensions & Animation
     SDL_Rect currentSourceRect;
     int standardFrameWidth, standardFrameHeight;
     int lyingFrameWidth, lyingFrameHeight;
-    float animTimer;
+    phys::Real animTimer;
     int currentAnimFrameIndex;
 
     // Physics & Collision
-    vector2d velocity;
+    phys::Vec2 velocity;
     SDL_Rect hitbox, originalStandingHitboxDef;
     bool isOnGround, isInWaterState;
-    float waterSurfaceY;
+    phys::Real waterSurfaceY;
     std::set<std::pair<int, int>> temporarilyDisabledTiles;
 
     // Game State & Input
     PlayerState currentState;
     FacingDirection facing;
     bool shootRequested, aimUpHeld, aimDownHeld, isShootingHeld;
+    bool moveHeld; // LEFT/RIGHT ở lần handleInput gần nhất; update() không tự đọc bàn phím
     bool isLyingDownState, isAimingStraightUpState;
     bool wantsToLieDown, wantsToStandUp, wantsToAimStraightUp, wantsToStopAimStraightUp;
-    float shootCooldownTimer;
+    phys::Real shootCooldownTimer;
     int lives;
     bool invulnerable;
-    float invulnerableTimer;
+    phys::Real invulnerableTimer;
     bool isVisible;      
-    float dyingTimer;   
+    phys::Real dyingTimer;   
 
-    // Map Data (con trỏ)
-    const std::vector<std::vector<int>>* currentMapData;
+    // Map Data (con trỏ, không sở hữu)
+    const TileMap* currentMap;
     int currentMapRows, currentMapCols, currentTileWidth, currentTileHeight;
 
     // Private Methods
-    void applyGravity(float dt); void movePlayer(float dt); void checkMapCollision();
-    void updateCurrentState(); void updatePlayerAnimation(float dt); void restoreDisabledTiles();
+    void applyGravity(phys::Real dt); void movePlayer(phys::Real dt); void sweepMapCollision(const phys::Vec2& beforeMove); void checkMapCollision();
+    void updateCurrentState(); void updatePlayerAnimation(phys::Real dt); void restoreDisabledTiles();
     void applyStateBasedMovementRestrictions(); PlayerState determineAimingOrShootingState() const;
 };
 
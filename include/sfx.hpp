@@ -0,0 +1,22 @@
+#pragma once
+
+#include <limits>
+
+// Các hiệu ứng âm thanh mà logic game có thể yêu cầu phát.
+// contra_core không link SDL_mixer: nó chỉ báo "muốn phát âm thanh gì, ở đâu",
+// còn target game đăng ký handler để map sang Mix_Chunk tương ứng.
+enum class SoundEffect {
+    PLAYER_SHOOT, PLAYER_DEATH, ENEMY_DEATH, TURRET_SHOOT, TURRET_EXPLOSION
+};
+
+namespace sfx {
+    // x không có vị trí: phát giữa, không giảm theo khoảng cách
+    constexpr float NO_POSITION = std::numeric_limits<float>::quiet_NaN();
+
+    // x: tọa độ x trong màn chơi của nguồn âm (để game pan/giảm âm lượng theo camera), hoặc NO_POSITION
+    using PlayHandler = void (*)(SoundEffect effect, float x);
+
+    // Đặt nullptr để tắt tiếng (mặc định khi chạy headless)
+    void setHandler(PlayHandler handler);
+    void play(SoundEffect effect, float x = NO_POSITION);
+}
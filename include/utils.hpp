@@ -3,14 +3,15 @@
 #include<SDL2/SDL.h>
 #include "math.hpp" // Cho vector2d
 #include <cmath>    // Cho std::sqrt
+#include <algorithm> // Cho std::max, std::min
 
 namespace utils
 {
-    inline double hireTimeInSeconds() // Giữ double nếu bạn dùng double cho timing
+    // Thời gian từ bộ đếm hiệu năng (độ phân giải micro giây trở xuống), không phải SDL_GetTicks() theo ms
+    inline double hireTimeInSeconds()
     {
-        double t = SDL_GetTicks();
-        t *= 0.001; // Sửa 0.001d thành 0.001
-        return t;
+        static const double invFrequency = 1.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+        return static_cast<double>(SDL_GetPerformanceCounter()) * invFrequency;
     }
 
     // Hàm tính khoảng cách giữa hai vector2d
@@ -20,6 +21,11 @@ namespace utils
         return std::sqrt(dx * dx + dy * dy);
     }
 
+    // Nội suy tuyến tính, t = 0 trả về a, t = 1 trả về b
+    inline float lerp(float a, float b, float t) {
+        return a + (b - a) * t;
+    }
+
     // Hàm clamp giá trị trong một khoảng
     template <typename T>
     inline T clamp(const T& value, const T& min_val, const T& max_val) {
@@ -0,0 +1,87 @@
+#include "AabbBatch.hpp"
+#include <algorithm>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define CONTRA_AABB_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CONTRA_AABB_SSE2 1
+#endif
+
+namespace {
+
+int popcount(unsigned v) {
+    int n = 0;
+    for (; v; v &= v - 1) ++n;
+    return n;
+}
+
+// Hộp k giao query khi khoảng mở của hai hộp chồng nhau trên cả hai trục
+inline bool overlaps(const aabb::Box& q, float minX, float minY, float maxX, float maxY) {
+    return q.minX < maxX && minX < q.maxX && q.minY < maxY && minY < q.maxY;
+}
+
+std::size_t scalarRange(const aabb::Box& q, const float* minX, const float* minY, const float* maxX, const float* maxY,
+                        std::size_t first, std::size_t count, std::uint32_t* outMask) {
+    std::size_t hits = 0;
+    for (std::size_t k = first; k < count; ++k) {
+        if (overlaps(q, minX[k], minY[k], maxX[k], maxY[k])) {
+            outMask[k >> 5] |= 1u << (k & 31);
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+} // namespace
+
+namespace aabb {
+
+std::size_t intersectMaskScalar(const Box& query, const float* minX, const float* minY, const float* maxX, const float* maxY,
+                                std::size_t count, std::uint32_t* outMask) {
+    std::fill(outMask, outMask + (count + 31) / 32, 0u);
+    return scalarRange(query, minX, minY, maxX, maxY, 0, count, outMask);
+}
+
+std::size_t intersectMask(const Box& query, const float* minX, const float* minY, const float* maxX, const float* maxY,
+                          std::size_t count, std::uint32_t* outMask) {
+    std::fill(outMask, outMask + (count + 31) / 32, 0u);
+    std::size_t k = 0, hits = 0;
+#if defined(CONTRA_AABB_AVX2)
+    const __m256 qMinX = _mm256_set1_ps(query.minX), qMinY = _mm256_set1_ps(query.minY);
+    const __m256 qMaxX = _mm256_set1_ps(query.maxX), qMaxY = _mm256_set1_ps(query.maxY);
+    for (; k + 8 <= count; k += 8) {
+        __m256 x = _mm256_and_ps(_mm256_cmp_ps(qMinX, _mm256_loadu_ps(maxX + k), _CMP_LT_OQ),
+                                 _mm256_cmp_ps(_mm256_loadu_ps(minX + k), qMaxX, _CMP_LT_OQ));
+        __m256 y = _mm256_and_ps(_mm256_cmp_ps(qMinY, _mm256_loadu_ps(maxY + k), _CMP_LT_OQ),
+                                 _mm256_cmp_ps(_mm256_loadu_ps(minY + k), qMaxY, _CMP_LT_OQ));
+        unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(x, y)));
+        outMask[k >> 5] |= bits << (k & 31); // k là bội của 8 nên 8 bit không vắt qua hai word
+        hits += popcount(bits);
+    }
+#elif defined(CONTRA_AABB_SSE2)
+    const __m128 qMinX = _mm_set1_ps(query.minX), qMinY = _mm_set1_ps(query.minY);
+    const __m128 qMaxX = _mm_set1_ps(query.maxX), qMaxY = _mm_set1_ps(query.maxY);
+    for (; k + 4 <= count; k += 4) {
+        __m128 x = _mm_and_ps(_mm_cmplt_ps(qMinX, _mm_loadu_ps(maxX + k)), _mm_cmplt_ps(_mm_loadu_ps(minX + k), qMaxX));
+        __m128 y = _mm_and_ps(_mm_cmplt_ps(qMinY, _mm_loadu_ps(maxY + k)), _mm_cmplt_ps(_mm_loadu_ps(minY + k), qMaxY));
+        unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(x, y)));
+        outMask[k >> 5] |= bits << (k & 31);
+        hits += popcount(bits);
+    }
+#endif
+    return hits + scalarRange(query, minX, minY, maxX, maxY, k, count, outMask);
+}
+
+const char* kernelName() {
+#if defined(CONTRA_AABB_AVX2)
+    return "avx2";
+#elif defined(CONTRA_AABB_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace aabb
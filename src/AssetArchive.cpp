@@ -0,0 +1,153 @@
+#include "AssetArchive.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::AssetArchive()
+    : base(nullptr), length(0), header(nullptr), entries(nullptr)
+#ifdef _WIN32
+    , file(INVALID_HANDLE_VALUE), mapping(nullptr)
+#endif
+{}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { close(); return false; }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) { std::cout << "Failed to map " << path << std::endl; close(); return false; }
+    base = static_cast<const std::uint8_t*>(view);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) { ::close(fd); return false; }
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // Mapping giữ file mở
+    if (view == MAP_FAILED) { std::cout << "Failed to map " << path << std::endl; return false; }
+    base = static_cast<const std::uint8_t*>(view);
+    length = static_cast<std::size_t>(info.st_size);
+#endif
+
+    header = reinterpret_cast<const pack::Header*>(base);
+    if (!validate()) {
+        std::cout << "Ignoring " << path << ": not a valid version " << pack::VERSION << " asset archive." << std::endl;
+        close();
+        return false;
+    }
+    entries = reinterpret_cast<const pack::Entry*>(base + header->indexOffset);
+    return true;
+}
+
+void AssetArchive::close() {
+#ifdef _WIN32
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if (base) munmap(const_cast<std::uint8_t*>(base), length);
+#endif
+    base = nullptr;
+    length = 0;
+    header = nullptr;
+    entries = nullptr;
+}
+
+// Kiểm tra mọi offset nằm trong file, để entry hỏng không đọc ra ngoài vùng map
+bool AssetArchive::validate() const {
+    if (length < sizeof(pack::Header)) return false;
+    if (std::memcmp(header->magic, pack::MAGIC, sizeof(pack::MAGIC)) != 0 || header->version != pack::VERSION) return false;
+    if (header->indexOffset % alignof(pack::Entry) != 0 || header->indexOffset > length ||
+        header->entryCount > (length - header->indexOffset) / sizeof(pack::Entry) || header->namesOffset > length) return false;
+    const pack::Entry* index = reinterpret_cast<const pack::Entry*>(base + header->indexOffset);
+    for (std::uint32_t i = 0; i < header->entryCount; ++i) {
+        const pack::Entry& entry = index[i];
+        if (entry.offset > length || entry.size > length - entry.offset) return false;
+        if (entry.nameOffset > length - header->namesOffset || entry.nameLength > length - header->namesOffset - entry.nameOffset) return false;
+        if (entry.type == pack::EntryType::IMAGE &&
+            (entry.width <= 0 || entry.height <= 0 || static_cast<std::uint64_t>(entry.width) * entry.height * 4 != entry.size)) return false;
+    }
+    return true;
+}
+
+// Bảng Entry sắp theo tên nên tìm nhị phân
+const pack::Entry* AssetArchive::find(const std::string& name) const {
+    if (!header) return nullptr;
+    const char* names = reinterpret_cast<const char*>(base + header->namesOffset);
+    auto nameOf = [names](const pack::Entry& entry) { return std::string_view(names + entry.nameOffset, entry.nameLength); };
+    const pack::Entry* end = entries + header->entryCount;
+    const pack::Entry* found = std::lower_bound(entries, end, std::string_view(name), [&nameOf](const pack::Entry& entry, std::string_view key) { return nameOf(entry) < key; });
+    return found != end && nameOf(*found) == name ? found : nullptr;
+}
+
+const pack::Entry* AssetArchive::find(const std::string& name, pack::EntryType type) const {
+    const pack::Entry* entry = find(name);
+    return entry && entry->type == type ? entry : nullptr;
+}
+
+SDL_Surface* AssetArchive::surface(const std::string& name) const {
+    const pack::Entry* entry = find(name, pack::EntryType::IMAGE);
+    if (!entry) return nullptr;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(data(*entry), entry->width, entry->height, 32, entry->width * 4, entry->format);
+    if (!surface) std::cout << "Failed to wrap " << name << ". Error: " << SDL_GetError() << std::endl;
+    return surface;
+}
+
+SDL_Texture* AssetArchive::texture(SDL_Renderer* renderer, const std::string& name) const {
+    const pack::Entry* entry = find(name, pack::EntryType::IMAGE);
+    if (!entry) return nullptr;
+    SDL_Texture* texture = SDL_CreateTexture(renderer, entry->format, SDL_TEXTUREACCESS_STATIC, entry->width, entry->height);
+    if (!texture || SDL_UpdateTexture(texture, NULL, data(*entry), entry->width * 4) != 0) {
+        std::cout << "Failed to upload texture " << name << ". Error: " << SDL_GetError() << std::endl;
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND); // Như SDL_CreateTextureFromSurface với ảnh có alpha
+    return texture;
+}
+
+Mix_Chunk* AssetArchive::sound(const std::string& name) const {
+    const pack::Entry* entry = find(name, pack::EntryType::SOUND);
+    if (!entry) return nullptr;
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (!Mix_QuerySpec(&frequency, &format, &channels) || frequency != entry->width || channels != entry->height || format != entry->format) return nullptr;
+    return Mix_QuickLoad_RAW(data(*entry), static_cast<Uint32>(entry->size)); // Chunk không sở hữu buffer
+}
+
+Mix_Music* AssetArchive::music(const std::string& name) const {
+    const pack::Entry* entry = find(name, pack::EntryType::BLOB);
+    if (!entry) return nullptr;
+    Mix_Music* music = Mix_LoadMUS_RW(SDL_RWFromConstMem(data(*entry), static_cast<int>(entry->size)), 1);
+    if (!music) std::cout << "Failed to open music " << name << ". Error: " << Mix_GetError() << std::endl;
+    return music;
+}
+
+TTF_Font* AssetArchive::font(const std::string& name, int ptsize) const {
+    const pack::Entry* entry = find(name, pack::EntryType::BLOB);
+    if (!entry) return nullptr;
+    return TTF_OpenFontRW(SDL_RWFromConstMem(data(*entry), static_cast<int>(entry->size)), 1, ptsize);
+}
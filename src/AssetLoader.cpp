@@ -0,0 +1,140 @@
+#include "AssetLoader.hpp"
+#include "Qoi.hpp"
+#include <algorithm>
+#include <iostream>
+
+AssetLoader::AssetLoader(int p_workerCount)
+    : stopping(false), finishedJobs(0)
+{
+    int count = std::max(1, std::min(p_workerCount, MAX_WORKERS));
+    for (int i = 0; i < count; ++i) workers.emplace_back(&AssetLoader::workerLoop, this);
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    for (std::unique_ptr<Job>& job : jobs) {
+        SDL_FreeSurface(job->surface);
+        if (job->chunk) Mix_FreeChunk(job->chunk);
+        if (job->music) Mix_FreeMusic(job->music);
+    }
+}
+
+int AssetLoader::defaultWorkerCount() {
+    // Chừa một lõi cho main thread đang vẽ màn hình loading
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(cores - 1, MAX_WORKERS));
+}
+
+int AssetLoader::loadImage(const std::string& path, Uint32 format) { return submit(Kind::IMAGE, path, format); }
+int AssetLoader::loadSound(const std::string& path) { return submit(Kind::SOUND, path); }
+int AssetLoader::loadMusic(const std::string& path) { return submit(Kind::MUSIC, path); }
+
+int AssetLoader::submit(Kind kind, const std::string& path, Uint32 format) {
+    jobs.push_back(std::unique_ptr<Job>(new Job()));
+    Job* job = jobs.back().get();
+    job->kind = kind;
+    job->path = path;
+    job->format = format;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(job);
+    }
+    wake.notify_one();
+    return static_cast<int>(jobs.size() - 1);
+}
+
+void AssetLoader::wait(int id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Job& job = *jobs[id];
+    finished.wait(lock, [&job] { return job.finished.load(std::memory_order_acquire); });
+}
+
+void AssetLoader::waitAll() {
+    for (int id = 0; id < size(); ++id) wait(id);
+}
+
+AssetLoader::Job& AssetLoader::result(int id, Kind kind) {
+    wait(id);
+    Job& job = *jobs[id];
+    if (job.kind != kind) std::cout << "Asset " << job.path << " requested as the wrong type." << std::endl;
+    if (!job.error.empty()) {
+        std::cout << "Failed to load " << job.path << ". Error: " << job.error << std::endl;
+        job.error.clear(); // Chỉ log một lần
+    }
+    return job;
+}
+
+SDL_Surface* AssetLoader::takeSurface(int id) {
+    Job& job = result(id, Kind::IMAGE);
+    SDL_Surface* surface = job.surface;
+    job.surface = nullptr;
+    return surface;
+}
+
+SDL_Texture* AssetLoader::takeTexture(int id, SDL_Renderer* renderer) {
+    SDL_Surface* surface = takeSurface(id);
+    if (!surface) return nullptr;
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) std::cout << "Failed to upload texture " << jobs[id]->path << ". Error: " << SDL_GetError() << std::endl;
+    SDL_FreeSurface(surface);
+    return texture;
+}
+
+Mix_Chunk* AssetLoader::takeSound(int id) {
+    Job& job = result(id, Kind::SOUND);
+    Mix_Chunk* chunk = job.chunk;
+    job.chunk = nullptr;
+    return chunk;
+}
+
+Mix_Music* AssetLoader::takeMusic(int id) {
+    Job& job = result(id, Kind::MUSIC);
+    Mix_Music* music = job.music;
+    job.music = nullptr;
+    return music;
+}
+
+// --- Worker ---
+void AssetLoader::workerLoop() {
+    for (;;) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = queue.front();
+            queue.pop_front();
+        }
+        run(*job);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job->finished.store(true, std::memory_order_release);
+        }
+        finishedJobs.fetch_add(1, std::memory_order_acq_rel);
+        finished.notify_all();
+    }
+}
+
+// Lỗi SDL là biến thread-local nên phải chép lại ngay trên worker
+void AssetLoader::run(Job& job) {
+    switch (job.kind) {
+        case Kind::IMAGE:
+            job.surface = qoi::loadPreferred(job.path, job.format);
+            if (!job.surface) job.error = SDL_GetError(); // IMG_GetError cũng là SDL_GetError
+            break;
+        case Kind::SOUND:
+            job.chunk = Mix_LoadWAV(job.path.c_str());
+            if (!job.chunk) job.error = Mix_GetError();
+            break;
+        case Kind::MUSIC:
+            job.music = Mix_LoadMUS(job.path.c_str());
+            if (!job.music) job.error = Mix_GetError();
+            break;
+    }
+}
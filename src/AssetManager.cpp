@@ -0,0 +1,250 @@
+#include "AssetManager.hpp"
+#include "AssetArchive.hpp"
+#include "Qoi.hpp"
+#include <algorithm>
+#include <iostream>
+
+// Load đồng bộ một ảnh thành texture riêng (tài nguyên xin sau build())
+static SDL_Texture* loadTexture(SDL_Renderer* renderer, const std::string& path, Uint32 format) {
+    SDL_Surface* surface = qoi::loadPreferred(path, format);
+    if (!surface) {
+        std::cout << "Failed to load " << path << ". Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) std::cout << "Failed to upload texture " << path << ". Error: " << SDL_GetError() << std::endl;
+    SDL_FreeSurface(surface);
+    return texture;
+}
+
+AssetManager::AssetManager(SDL_Renderer* p_renderer, const AssetArchive* p_archive, bool p_hotReload)
+    : renderer(p_renderer), archive(p_archive), textureFormat(qoi::preferredFormat(p_renderer)), asyncLoader(new AssetLoader()),
+      atlas(new TextureAtlas(p_renderer)), built(false), hotReload(p_hotReload), lastPoll(0.0)
+{
+    atlas->setDeduplicate(!hotReload);
+}
+
+AssetManager::~AssetManager() {
+    asyncLoader.reset(); // Dừng worker trước khi giải phóng
+    for (Entry& entry : entries) {
+        SDL_DestroyTexture(entry.texture);
+        if (entry.chunk) Mix_FreeChunk(entry.chunk);
+        if (entry.music) Mix_FreeMusic(entry.music);
+    }
+}
+
+std::string AssetManager::key(Kind kind, const std::string& path, int columns) {
+    return std::to_string(static_cast<int>(kind)) + ':' + std::to_string(columns) + ':' + path;
+}
+
+// Lỗi (file đang bị ghi lại, bị xóa) trả về min: không coi là đã đổi
+std::filesystem::file_time_type AssetManager::modifiedTime(const std::string& path) {
+    std::error_code error;
+    std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+
+SpriteHandle AssetManager::sprite(const std::string& path, int columns) { return SpriteHandle{ acquire(Kind::SPRITE, path, std::max(columns, 1)) }; }
+TextureHandle AssetManager::texture(const std::string& path) { return TextureHandle{ acquire(Kind::TEXTURE, path, 1) }; }
+SoundHandle AssetManager::sound(const std::string& path) { return SoundHandle{ acquire(Kind::SOUND, path, 1) }; }
+MusicHandle AssetManager::music(const std::string& path) { return MusicHandle{ acquire(Kind::MUSIC, path, 1) }; }
+
+int AssetManager::acquire(Kind kind, const std::string& path, int columns) {
+    std::string entryKey = key(kind, path, columns);
+    auto found = index.find(entryKey);
+    if (found != index.end()) {
+        ++entries[found->second].refs;
+        return found->second;
+    }
+
+    entries.push_back(Entry{ kind, path, columns, 1, -1, -1, SpriteSheet() });
+    Entry& entry = entries.back();
+    entry.modified = modifiedTime(path);
+    if (loadArchived(entry)) {
+        // Đã có sẵn trong archive, không cần giải mã
+    } else if (built) {
+        load(entry);
+    } else {
+        switch (kind) {
+            case Kind::SPRITE: entry.atlasHandle = atlas->add(path, *asyncLoader); break; // Atlas tự gộp file trùng
+            case Kind::TEXTURE: entry.job = asyncLoader->loadImage(path, textureFormat); break;
+            case Kind::SOUND: entry.job = asyncLoader->loadSound(path); break;
+            case Kind::MUSIC: entry.job = asyncLoader->loadMusic(path); break;
+        }
+    }
+    int id = static_cast<int>(entries.size() - 1);
+    index.emplace(entryKey, id);
+    return id;
+}
+
+void AssetManager::release(SpriteHandle& handle) { if (handle) unload(handle.id); handle.id = -1; }
+void AssetManager::release(TextureHandle& handle) { if (handle) unload(handle.id); handle.id = -1; }
+void AssetManager::release(SoundHandle& handle) { if (handle) unload(handle.id); handle.id = -1; }
+void AssetManager::release(MusicHandle& handle) { if (handle) unload(handle.id); handle.id = -1; }
+
+void AssetManager::unload(int id) {
+    Entry& entry = entries[id];
+    if (entry.refs == 0 || --entry.refs > 0) return;
+    if (entry.atlasHandle >= 0) return; // Ô atlas giữ lại, xin lại thì dùng tiếp
+    // Job chưa lấy thì kết quả do loader giải phóng
+    SDL_DestroyTexture(entry.texture);
+    if (entry.chunk) Mix_FreeChunk(entry.chunk);
+    if (entry.music) Mix_FreeMusic(entry.music);
+    entry.texture = nullptr; entry.chunk = nullptr; entry.music = nullptr;
+    entry.sheet = SpriteSheet();
+    entry.job = -1;
+    index.erase(key(entry.kind, entry.path, entry.columns));
+}
+
+bool AssetManager::build() {
+    if (built) return true;
+    bool ok = atlas->build();
+    for (Entry& entry : entries) {
+        if (entry.refs == 0) continue;
+        collect(entry);
+        switch (entry.kind) {
+            case Kind::SPRITE:
+                entry.sheet = SpriteSheet::of(atlas->region(entry.atlasHandle), entry.columns);
+                ok = ok && entry.sheet;
+                break;
+            case Kind::TEXTURE: ok = ok && entry.texture; break;
+            case Kind::SOUND: ok = ok && entry.chunk; break;
+            case Kind::MUSIC: ok = ok && entry.music; break;
+        }
+    }
+    asyncLoader.reset();
+    built = true;
+    return ok;
+}
+
+void AssetManager::collect(Entry& entry) {
+    if (entry.job < 0) return;
+    switch (entry.kind) {
+        case Kind::TEXTURE: entry.texture = asyncLoader->takeTexture(entry.job, renderer); break;
+        case Kind::SOUND: entry.chunk = asyncLoader->takeSound(entry.job); break;
+        case Kind::MUSIC: entry.music = asyncLoader->takeMusic(entry.job); break;
+        case Kind::SPRITE: break;
+    }
+    entry.job = -1;
+}
+
+bool AssetManager::loadArchived(Entry& entry) {
+    if (!archive || !archive->contains(entry.path)) return false;
+    switch (entry.kind) {
+        case Kind::SPRITE:
+            if (!built) {
+                entry.atlasHandle = atlas->add(entry.path, archive->surface(entry.path));
+                return entry.atlasHandle >= 0;
+            }
+            entry.texture = archive->texture(renderer, entry.path);
+            entry.sheet = SpriteSheet::of(wholeTexture(entry.texture), entry.columns);
+            return entry.texture != nullptr;
+        case Kind::TEXTURE: entry.texture = archive->texture(renderer, entry.path); return entry.texture != nullptr;
+        case Kind::SOUND: entry.chunk = archive->sound(entry.path); return entry.chunk != nullptr;
+        case Kind::MUSIC: entry.music = archive->music(entry.path); return entry.music != nullptr;
+    }
+    return false;
+}
+
+void AssetManager::load(Entry& entry) {
+    switch (entry.kind) {
+        case Kind::SPRITE:
+            entry.texture = loadTexture(renderer, entry.path, textureFormat);
+            entry.sheet = SpriteSheet::of(wholeTexture(entry.texture), entry.columns);
+            break;
+        case Kind::TEXTURE: entry.texture = loadTexture(renderer, entry.path, textureFormat); break;
+        case Kind::SOUND:
+            entry.chunk = Mix_LoadWAV(entry.path.c_str());
+            if (!entry.chunk) std::cout << "Failed to load " << entry.path << ". Error: " << Mix_GetError() << std::endl;
+            break;
+        case Kind::MUSIC:
+            entry.music = Mix_LoadMUS(entry.path.c_str());
+            if (!entry.music) std::cout << "Failed to load " << entry.path << ". Error: " << Mix_GetError() << std::endl;
+            break;
+    }
+}
+
+const SpriteSheet& AssetManager::sheet(SpriteHandle handle) const {
+    static const SpriteSheet empty;
+    return handle ? entries[handle.id].sheet : empty;
+}
+
+SDL_Texture* AssetManager::get(TextureHandle handle) {
+    if (!handle) return nullptr;
+    Entry& entry = entries[handle.id];
+    if (entry.job >= 0 && asyncLoader->isReady(entry.job)) collect(entry);
+    return entry.texture;
+}
+
+Mix_Chunk* AssetManager::get(SoundHandle handle) const { return handle ? entries[handle.id].chunk : nullptr; }
+Mix_Music* AssetManager::get(MusicHandle handle) const { return handle ? entries[handle.id].music : nullptr; }
+
+int AssetManager::liveCount() const {
+    return static_cast<int>(std::count_if(entries.begin(), entries.end(), [](const Entry& entry) { return entry.refs > 0; }));
+}
+
+// --- Hot reload ---
+int AssetManager::pollChanges(double now) {
+    if (!built || !hotReload || now - lastPoll < POLL_INTERVAL) return 0;
+    lastPoll = now;
+    int reloaded = 0;
+    std::vector<int> reloadedCells; // Hai sheet cùng file (khác số cột) chung một ô, chỉ ghi một lần
+    for (Entry& entry : entries) {
+        if (entry.refs == 0 || entry.kind == Kind::MUSIC) continue;
+        std::filesystem::file_time_type modified = modifiedTime(entry.path);
+        if (modified == entry.modified || modified == std::filesystem::file_time_type::min()) continue;
+        entry.modified = modified;
+        if (entry.atlasHandle >= 0) {
+            if (std::find(reloadedCells.begin(), reloadedCells.end(), entry.atlasHandle) != reloadedCells.end()) continue;
+            reloadedCells.push_back(entry.atlasHandle);
+        }
+        if (reload(entry)) {
+            std::cout << "Reloaded " << entry.path << std::endl;
+            ++reloaded;
+        }
+    }
+    return reloaded;
+}
+
+bool AssetManager::reload(Entry& entry) {
+    switch (entry.kind) {
+        case Kind::SPRITE:
+            if (entry.atlasHandle < 0) return reloadTexture(entry.texture, entry.path);
+            {
+                SDL_Surface* surface = qoi::loadPreferred(entry.path, SDL_PIXELFORMAT_RGBA32);
+                if (!surface) { std::cout << "Failed to reload " << entry.path << ". Error: " << SDL_GetError() << std::endl; return false; }
+                return atlas->reload(entry.atlasHandle, surface);
+            }
+        case Kind::TEXTURE: return reloadTexture(entry.texture, entry.path);
+        case Kind::SOUND: {
+            Mix_Chunk* chunk = Mix_LoadWAV(entry.path.c_str());
+            if (!chunk) { std::cout << "Failed to reload " << entry.path << ". Error: " << Mix_GetError() << std::endl; return false; }
+            if (entry.chunk) Mix_FreeChunk(entry.chunk); // SDL_mixer dừng các kênh đang phát chunk cũ
+            entry.chunk = chunk;
+            return true;
+        }
+        case Kind::MUSIC: return false;
+    }
+    return false;
+}
+
+// Ghi pixel mới vào texture cũ để ai đang giữ con trỏ (TileLayer, HudLayer) thấy ngay; đổi kích thước thì giữ ảnh cũ
+bool AssetManager::reloadTexture(SDL_Texture* texture, const std::string& path) {
+    if (!texture) return false;
+    SDL_Surface* surface = qoi::loadPreferred(path, textureFormat);
+    if (!surface) { std::cout << "Failed to reload " << path << ". Error: " << SDL_GetError() << std::endl; return false; }
+    Uint32 format;
+    int w, h;
+    SDL_QueryTexture(texture, &format, NULL, &w, &h);
+    bool ok = false;
+    if (surface->w != w || surface->h != h) {
+        std::cout << "Cannot reload " << path << ": size changed, restart to load it." << std::endl;
+    } else {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+        ok = converted && SDL_UpdateTexture(texture, NULL, converted->pixels, converted->pitch) == 0;
+        if (!ok) std::cout << "Failed to reload " << path << ". Error: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(converted);
+    }
+    SDL_FreeSurface(surface);
+    return ok;
+}
@@ -0,0 +1,80 @@
+#include "BulletPool.hpp"
+#include <algorithm>
+
+BulletPool::BulletPool(std::size_t p_capacity)
+    : posX(p_capacity), posY(p_capacity), velX(p_capacity), velY(p_capacity),
+      lifeTime(p_capacity), renderW(p_capacity), renderH(p_capacity), texId(p_capacity),
+      prevX(p_capacity), prevY(p_capacity), count(0)
+{
+}
+
+bool BulletPool::spawn(vector2d p_pos, vector2d p_vel, int p_renderW, int p_renderH, std::uint16_t p_texId) {
+    return spawn(phys::Vec2{ phys::real(p_pos.x), phys::real(p_pos.y) }, phys::Vec2{ phys::real(p_vel.x), phys::real(p_vel.y) },
+                 p_renderW, p_renderH, p_texId);
+}
+
+bool BulletPool::spawn(phys::Vec2 p_pos, phys::Vec2 p_vel, int p_renderW, int p_renderH, std::uint16_t p_texId) {
+    if (full()) return false;
+    std::size_t i = count++;
+    posX[i] = p_pos.x; posY[i] = p_pos.y;
+    prevX[i] = posX[i]; prevY[i] = posY[i]; // Viên mới hiện ngay tại nòng súng
+    velX[i] = p_vel.x; velY[i] = p_vel.y;
+    lifeTime[i] = phys::Real();
+    renderW[i] = p_renderW; renderH[i] = p_renderH;
+    texId[i] = p_texId;
+    return true;
+}
+
+void BulletPool::update(float p_dt) {
+    const std::size_t n = count;
+    const phys::Real dt = phys::real(p_dt);
+    const phys::Real maxLifetime = phys::real(MAX_LIFETIME);
+    phys::Real* px = posX.data(); phys::Real* py = posY.data();
+    const phys::Real* vx = velX.data(); const phys::Real* vy = velY.data();
+    phys::Real* life = lifeTime.data();
+    phys::Real* ppx = prevX.data(); phys::Real* ppy = prevY.data();
+
+    // Vòng lặp phẳng, không rẽ nhánh: compiler tự vector hóa được
+    for (std::size_t i = 0; i < n; ++i) {
+        ppx[i] = px[i]; ppy[i] = py[i];
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        life[i] += dt;
+    }
+
+    for (std::size_t i = 0; i < count; ) {
+        if (lifeTime[i] >= maxLifetime) remove(i);
+        else ++i;
+    }
+}
+
+void BulletPool::remove(std::size_t i) {
+    std::size_t last = --count;
+    if (i == last) return;
+    posX[i] = posX[last]; posY[i] = posY[last];
+    velX[i] = velX[last]; velY[i] = velY[last];
+    lifeTime[i] = lifeTime[last];
+    renderW[i] = renderW[last]; renderH[i] = renderH[last];
+    texId[i] = texId[last];
+    prevX[i] = prevX[last]; prevY[i] = prevY[last];
+}
+
+std::uint16_t BulletPool::spriteId(const SpriteRegion& p_sprite) {
+    auto it = std::find_if(sprites.begin(), sprites.end(), [&p_sprite](const SpriteRegion& s) {
+        return s.texture == p_sprite.texture && s.rect.x == p_sprite.rect.x && s.rect.y == p_sprite.rect.y &&
+               s.rect.w == p_sprite.rect.w && s.rect.h == p_sprite.rect.h;
+    });
+    if (it != sprites.end()) return static_cast<std::uint16_t>(it - sprites.begin());
+    sprites.push_back(p_sprite);
+    return static_cast<std::uint16_t>(sprites.size() - 1);
+}
+
+void BulletPool::gatherBounds(float dt, AabbBatch& out) const {
+    out.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        float x1 = phys::toFloat(posX[i]), y1 = phys::toFloat(posY[i]);
+        float x0 = x1 - phys::toFloat(velX[i]) * dt, y0 = y1 - phys::toFloat(velY[i]) * dt;
+        out.set(i, aabb::Box{ std::min(x0, x1) - 0.5f, std::min(y0, y1) - 0.5f,
+                              std::max(x0, x1) + renderW[i] + 0.5f, std::max(y0, y1) + renderH[i] + 0.5f });
+    }
+}
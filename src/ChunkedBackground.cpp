@@ -0,0 +1,93 @@
+#include "ChunkedBackground.hpp"
+#include "Qoi.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+ChunkedBackground::ChunkedBackground(SDL_Renderer* p_renderer, const char* p_filePath, int p_chunkWidth)
+    : renderer(p_renderer), chunkWidth(std::max(1, p_chunkWidth)), width(0), height(0)
+{
+    SDL_Surface* image = qoi::loadPreferred(p_filePath, qoi::preferredFormat(p_renderer));
+    if (!image) {
+        std::cout << "Failed to load background. Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+    split(image);
+}
+
+ChunkedBackground::ChunkedBackground(SDL_Renderer* p_renderer, SDL_Surface* p_image, int p_chunkWidth)
+    : renderer(p_renderer), chunkWidth(std::max(1, p_chunkWidth)), width(0), height(0)
+{
+    if (p_image) split(p_image);
+}
+
+void ChunkedBackground::split(SDL_Surface* image) {
+    width = image->w;
+    height = image->h;
+
+    // Copy nguyên pixel (kể cả alpha) sang từng dải, không blend
+    SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+    for (int x = 0; x < width; x += chunkWidth) {
+        int w = std::min(chunkWidth, width - x);
+        SDL_Surface* part = SDL_CreateRGBSurfaceWithFormat(0, w, height, image->format->BitsPerPixel, image->format->format);
+        if (!part) {
+            std::cout << "Failed to create background chunk. Error: " << SDL_GetError() << std::endl;
+            continue;
+        }
+        SDL_Rect src = { x, 0, w, height };
+        SDL_BlitSurface(image, &src, part, NULL);
+        chunks.push_back(Chunk{ part, nullptr, x, w });
+    }
+    SDL_FreeSurface(image);
+}
+
+ChunkedBackground::~ChunkedBackground() {
+    for (Chunk& chunk : chunks) {
+        evict(chunk);
+        SDL_FreeSurface(chunk.surface);
+    }
+}
+
+int ChunkedBackground::residentCount() const {
+    return static_cast<int>(std::count_if(chunks.begin(), chunks.end(), [](const Chunk& c) { return c.texture != nullptr; }));
+}
+
+bool ChunkedBackground::makeResident(Chunk& chunk) {
+    if (!chunk.texture) {
+        chunk.texture = SDL_CreateTextureFromSurface(renderer, chunk.surface);
+        if (!chunk.texture) std::cout << "Failed to upload background chunk. Error: " << SDL_GetError() << std::endl;
+    }
+    return chunk.texture != nullptr;
+}
+
+void ChunkedBackground::evict(Chunk& chunk) {
+    if (chunk.texture) {
+        SDL_DestroyTexture(chunk.texture);
+        chunk.texture = nullptr;
+    }
+}
+
+void ChunkedBackground::update(float cameraX, int screenWidth) {
+    // Vùng hiển thị cộng thêm một màn hình mỗi bên: dải kế tiếp đã có sẵn trước khi camera tới
+    float keepFrom = cameraX - screenWidth, keepTo = cameraX + 2.0f * screenWidth;
+    for (Chunk& chunk : chunks) {
+        bool wanted = chunk.x < keepTo && chunk.x + chunk.w > keepFrom;
+        if (wanted) makeResident(chunk);
+        else evict(chunk);
+    }
+}
+
+void ChunkedBackground::render(float cameraX, float cameraY, int screenWidth, int screenHeight) {
+    int srcX = static_cast<int>(std::round(cameraX)), srcY = static_cast<int>(std::round(cameraY));
+    int viewTop = std::max(srcY, 0), viewBottom = std::min(srcY + screenHeight, height);
+    if (viewTop >= viewBottom) return;
+
+    for (Chunk& chunk : chunks) {
+        int x0 = std::max(srcX, chunk.x), x1 = std::min(srcX + screenWidth, chunk.x + chunk.w);
+        if (x0 >= x1) continue;
+        if (!makeResident(chunk)) continue;
+        SDL_Rect src = { x0 - chunk.x, viewTop, x1 - x0, viewBottom - viewTop };
+        SDL_Rect dst = { x0 - srcX, viewTop - srcY, x1 - x0, viewBottom - viewTop };
+        SDL_RenderCopy(renderer, chunk.texture, &src, &dst);
+    }
+}
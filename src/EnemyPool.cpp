@@ -0,0 +1,176 @@
+#include "EnemyPool.hpp"
+#include "sfx.hpp"
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+EnemyPool::EnemyPool(const SpriteSheet& p_sheet)
+    : sheet(p_sheet), frameWidth(DEFAULT_FRAME_W), frameHeight(DEFAULT_FRAME_H)
+{
+    if (sheet) {
+        frameWidth = sheet.frameWidth;
+        frameHeight = sheet.frameHeight;
+    }
+    // Mô phỏng headless không có texture: dùng kích thước mặc định của sprite lính
+
+    hitbox.w = frameWidth - 10;
+    hitbox.h = frameHeight - 5;
+    hitbox.x = (frameWidth - hitbox.w) / 2;
+    hitbox.y = frameHeight - hitbox.h;
+}
+
+std::size_t EnemyPool::spawn(vector2d p_pos) {
+    posX.push_back(phys::real(p_pos.x)); posY.push_back(phys::real(p_pos.y));
+    prevX.push_back(posX.back()); prevY.push_back(posY.back());
+    velocityY.push_back(phys::Real());
+    animTimer.push_back(phys::Real());
+    dyingTimer.push_back(phys::Real());
+    animFrame.push_back(0);
+    state.push_back(EnemyState::ALIVE);
+    onGround.push_back(0);
+    movingRight.push_back(0); // Lính bắt đầu đi sang trái
+    visible.push_back(1);
+    return posX.size() - 1;
+}
+
+void EnemyPool::clear() {
+    posX.clear(); posY.clear(); velocityY.clear(); animTimer.clear(); dyingTimer.clear();
+    animFrame.clear(); state.clear(); onGround.clear(); movingRight.clear(); visible.clear();
+    prevX.clear(); prevY.clear();
+}
+
+void EnemyPool::reserve(std::size_t n) {
+    posX.reserve(n); posY.reserve(n); velocityY.reserve(n); animTimer.reserve(n); dyingTimer.reserve(n);
+    animFrame.reserve(n); state.reserve(n); onGround.reserve(n); movingRight.reserve(n); visible.reserve(n);
+    prevX.reserve(n); prevY.reserve(n);
+}
+
+// --- Update Method ---
+void EnemyPool::update(float p_dt, const TileMap& map, float activeMinX, float activeMaxX) {
+    const phys::Real dt = phys::real(p_dt);
+    const phys::Real dyingDuration = phys::real(DYING_DURATION), blinkInterval = phys::real(BLINK_INTERVAL);
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!isActive(i, activeMinX, activeMaxX)) continue; // Xa camera: giữ nguyên vị trí và timer
+        prevX[i] = posX[i]; prevY[i] = posY[i];
+        switch (state[i]) {
+            case EnemyState::ALIVE:
+                updateAlive(i, dt, map);
+                break;
+            case EnemyState::DYING:
+                velocityY[i] = phys::Real();
+                dyingTimer[i] += dt;
+                if (dyingTimer[i] >= dyingDuration) {
+                    state[i] = EnemyState::DEAD;
+                    visible[i] = 0;
+                } else { visible[i] = (phys::floorToInt(dyingTimer[i] / blinkInterval) % 2 == 0); }
+                break;
+            case EnemyState::DEAD: break;
+        }
+    }
+}
+
+void EnemyPool::updateAlive(std::size_t i, phys::Real dt, const TileMap& map) {
+    const int tileHeight = map.getTileHeight();
+    const phys::Real moveAmount = phys::real(MOVE_SPEED) * dt;
+    phys::Real& x = posX[i];
+    phys::Real& y = posY[i];
+    phys::Real& vy = velocityY[i];
+
+    if (!onGround[i]) {
+        vy += phys::real(GRAVITY) * dt;
+        vy = std::min(vy, phys::real(MAX_FALL_SPEED));
+    }
+    phys::Real tentativeY = y + vy * dt;
+    bool grounded = false;
+    SDL_Rect nextWorldHitbox = getWorldHitbox(i);
+    nextWorldHitbox.y = phys::roundToInt(tentativeY + hitbox.y);
+    phys::Real feetX_left = phys::real(nextWorldHitbox.x + 1.0f);
+    phys::Real feetX_mid = phys::real(nextWorldHitbox.x + nextWorldHitbox.w / 2.0f);
+    phys::Real feetX_right = phys::real(nextWorldHitbox.x + nextWorldHitbox.w - 1.0f);
+    phys::Real feetY_check = phys::real(nextWorldHitbox.y + nextWorldHitbox.h + 0.1f);
+    bool standingOnGround = map.isStandableAtWorld(feetX_mid, feetY_check) ||
+                            map.isStandableAtWorld(feetX_left, feetY_check) ||
+                            map.isStandableAtWorld(feetX_right, feetY_check);
+    // Rơi qua hẳn một mặt đất trong một tick (tick rate thấp): điểm dò cuối tick không thấy, đáp luôn lên đó
+    int sweptRow = vy > phys::Real() ? map.firstStandableRowCrossed(feetX_left, feetX_right, y + frameHeight, feetY_check) : -1;
+    if (sweptRow >= 0 && sweptRow < map.rowAt(feetY_check)) {
+        y = phys::Real(sweptRow * tileHeight) - frameHeight;
+        vy = phys::Real();
+        grounded = true;
+    } else if (standingOnGround) {
+        int tileRowBelow = map.rowAt(feetY_check);
+        phys::Real groundSurfaceY = phys::Real(tileRowBelow * tileHeight);
+        if (phys::Real(nextWorldHitbox.y + nextWorldHitbox.h) >= groundSurfaceY - phys::real(0.1f)) {
+            y = groundSurfaceY - frameHeight;
+            vy = phys::Real();
+            grounded = true;
+        } else { y = tentativeY; }
+    } else { y = tentativeY; }
+    onGround[i] = grounded;
+
+    if (grounded) {
+        bool right = movingRight[i] != 0;
+        phys::Real checkX_ahead;
+        phys::Real checkY_wall = y + phys::Real(frameHeight) / 2;
+        phys::Real checkY_ground_ahead = y + frameHeight + 1;
+        if (right) checkX_ahead = x + frameWidth + 1;
+        else checkX_ahead = x - 1;
+        bool shouldTurn = false;
+        // Lính coi cả cỏ lẫn khối đặc phía trước là tường, và quay đầu trước mép vực
+        if (map.isStandableAtWorld(checkX_ahead, checkY_wall)) shouldTurn = true;
+        else if (!map.isStandableAtWorld(checkX_ahead, checkY_ground_ahead)) shouldTurn = true;
+        if (map.getRows() > 0 && map.getCols() > 0) {
+             phys::Real mapEdgeRight = phys::real(map.getWorldWidth());
+             if (right && (x + frameWidth + moveAmount > mapEdgeRight)) shouldTurn = true;
+             else if (!right && (x - moveAmount < phys::Real())) shouldTurn = true;
+        }
+        if (shouldTurn) right = !right;
+        movingRight[i] = right;
+        if (right) x += moveAmount;
+        else x -= moveAmount;
+
+        const phys::Real animSpeed = phys::real(ANIM_SPEED);
+        animTimer[i] += dt;
+        if (animTimer[i] >= animSpeed) {
+            animTimer[i] -= animSpeed;
+            animFrame[i] = static_cast<std::uint8_t>((animFrame[i] + 1) % NUM_FRAMES_WALK);
+        }
+    } else { animFrame[i] = 0; }
+}
+
+void EnemyPool::removeDead() {
+    for (std::size_t i = 0; i < size(); ) {
+        if (state[i] == EnemyState::DEAD) swapRemove(i); // Không tăng i: phần tử cuối vừa được chuyển vào
+        else ++i;
+    }
+}
+
+void EnemyPool::swapRemove(std::size_t i) {
+    std::size_t last = size() - 1;
+    if (i != last) {
+        posX[i] = posX[last]; posY[i] = posY[last];
+        velocityY[i] = velocityY[last];
+        animTimer[i] = animTimer[last];
+        dyingTimer[i] = dyingTimer[last];
+        animFrame[i] = animFrame[last];
+        state[i] = state[last];
+        onGround[i] = onGround[last];
+        movingRight[i] = movingRight[last];
+        visible[i] = visible[last];
+        prevX[i] = prevX[last]; prevY[i] = prevY[last];
+    }
+    posX.pop_back(); posY.pop_back(); velocityY.pop_back(); animTimer.pop_back(); dyingTimer.pop_back();
+    animFrame.pop_back(); state.pop_back(); onGround.pop_back(); movingRight.pop_back(); visible.pop_back();
+    prevX.pop_back(); prevY.pop_back();
+}
+
+void EnemyPool::takeHit(std::size_t i) {
+    if (state[i] == EnemyState::ALIVE) {
+        state[i] = EnemyState::DYING;
+        dyingTimer[i] = phys::Real();
+        visible[i] = 1;
+        sfx::play(SoundEffect::ENEMY_DEATH, phys::toFloat(posX[i]) + frameWidth / 2.0f);
+    }
+}
@@ -0,0 +1,26 @@
+#include "FrameLimiter.hpp"
+
+FrameLimiter::FrameLimiter(double p_targetFps)
+    : targetFps(0.0), frequency(SDL_GetPerformanceFrequency()), period(0), deadline(0)
+{
+    setTargetFps(p_targetFps);
+}
+
+void FrameLimiter::setTargetFps(double fps) {
+    targetFps = fps > 0.0 ? fps : 0.0;
+    period = targetFps > 0.0 ? static_cast<Uint64>(frequency / targetFps) : 0;
+    deadline = 0;
+}
+
+void FrameLimiter::wait() {
+    if (period == 0) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (deadline == 0 || now > deadline + period) {
+        deadline = now; // Frame đầu hoặc trễ quá một chu kỳ: bắt nhịp lại
+    } else {
+        const Uint64 spin = static_cast<Uint64>(SPIN_SECONDS * frequency);
+        if (deadline > now + spin) SDL_Delay(static_cast<Uint32>((deadline - now - spin) * 1000 / frequency));
+        while (SDL_GetPerformanceCounter() < deadline) {} // Phần cuối quay vòng cho chính xác
+    }
+    deadline += period;
+}
@@ -0,0 +1,113 @@
+#include "HudLayer.hpp"
+#include <cstdio>
+#include <iostream>
+
+HudLayer::HudLayer(SDL_Renderer* p_renderer, int p_width, int p_height,
+                   TextRenderer* p_uiText, TextRenderer* p_titleText, const SpriteRegion& p_medal)
+    : renderer(p_renderer), width(p_width), height(p_height), uiText(p_uiText), titleText(p_titleText), medal(p_medal),
+      texture(nullptr), compositeBlend(SDL_BLENDMODE_BLEND), score(0), lives(0), overlay(Overlay::NONE), dirty(true), bakes(0)
+{
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+        std::cout << "Failed to create HUD target, drawing HUD every frame. Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                             SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(texture, premultiplied) == 0) compositeBlend = premultiplied;
+    else SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+HudLayer::~HudLayer() {
+    SDL_DestroyTexture(texture);
+}
+
+void HudLayer::update(int p_score, int p_lives, Overlay p_overlay) {
+    if (p_score == score && p_lives == lives && p_overlay == overlay) return;
+    score = p_score; lives = p_lives; overlay = p_overlay;
+    dirty = true;
+}
+
+void HudLayer::render() {
+    if (!texture) { drawContents(); return; }
+
+    if (dirty) {
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+        Uint8 r, g, b, a;
+        SDL_BlendMode blend;
+        float scaleX, scaleY; // Đổi target làm scale về 1
+        SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+        SDL_GetRenderDrawBlendMode(renderer, &blend);
+        SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+
+        SDL_SetRenderTarget(renderer, texture);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        drawContents();
+
+        SDL_SetRenderTarget(renderer, previousTarget);
+        SDL_RenderSetScale(renderer, scaleX, scaleY);
+        SDL_SetRenderDrawBlendMode(renderer, blend);
+        SDL_SetRenderDrawColor(renderer, r, g, b, a);
+        dirty = false;
+        ++bakes;
+    }
+    SDL_RenderCopy(renderer, texture, NULL, NULL);
+}
+
+void HudLayer::drawContents() {
+    const SDL_Color white = { 255, 255, 255, 255 };
+    if (uiText->isLoaded()) {
+        char scoreText[32];
+        snprintf(scoreText, sizeof(scoreText), "SCORE: %d", score);
+        uiText->draw(batch, scoreText, SCORE_X, SCORE_Y, white);
+
+        // Huân chương xếp từ mép phải sang trái, mỗi mạng một cái
+        if (medal) {
+            for (int i = 0; i < lives; ++i) {
+                SDL_Rect dst = { width - MEDAL_RIGHT_MARGIN - (i + 1) * MEDAL_RENDER_WIDTH - i * MEDAL_SPACING, MEDAL_TOP_MARGIN,
+                                 MEDAL_RENDER_WIDTH, MEDAL_RENDER_HEIGHT };
+                batch.draw(medal.texture, medal.rect, dst, false, SpriteBatch::LAYER_HUD);
+            }
+        }
+        batch.flush(renderer); // Điểm và huân chương nằm dưới lớp phủ
+    }
+
+    if (overlay == Overlay::NONE) return;
+    SDL_Rect full = { 0, 0, width, height };
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    switch (overlay) {
+        case Overlay::PAUSED: {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150);
+            SDL_RenderFillRect(renderer, &full);
+            const char* text = "PAUSED";
+            SDL_Point size = titleText->staticSize(text, white);
+            titleText->drawStatic(batch, text, (width - size.x) / 2, (height - size.y) / 2, white);
+        } break;
+        case Overlay::WON:
+            SDL_SetRenderDrawColor(renderer, 0, 180, 0, 170);
+            SDL_RenderFillRect(renderer, &full);
+            drawResultText("YOU WIN!", SDL_Color{ 255, 255, 0, 255 });
+            break;
+        case Overlay::GAME_OVER:
+            SDL_SetRenderDrawColor(renderer, 180, 0, 0, 170);
+            SDL_RenderFillRect(renderer, &full);
+            drawResultText("GAME OVER", white);
+            break;
+        case Overlay::NONE: break;
+    }
+    batch.flush(renderer);
+}
+
+// Tiêu đề và dòng hướng dẫn là chuỗi cố định (cache), dòng điểm xếp từ glyph
+void HudLayer::drawResultText(const char* title, SDL_Color color) {
+    const char* hint = "Press Enter or ESC";
+    char scoreText[48];
+    snprintf(scoreText, sizeof(scoreText), "FINAL SCORE: %d", score);
+    SDL_Point titleSize = titleText->staticSize(title, color), hintSize = uiText->staticSize(hint, color);
+    int scoreW = uiText->measure(scoreText), scoreH = uiText->lineHeight();
+    int y = height / 2 - titleSize.y - scoreH - 15;
+    titleText->drawStatic(batch, title, (width - titleSize.x) / 2, y, color); y += titleSize.y + 5;
+    uiText->draw(batch, scoreText, (width - scoreW) / 2, y, color); y += scoreH + 15;
+    uiText->drawStatic(batch, hint, (width - hintSize.x) / 2, y, color);
+}
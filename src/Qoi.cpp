@@ -0,0 +1,238 @@
+#include "Qoi.hpp"
+#include <SDL2/SDL_image.h>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+constexpr std::uint8_t OP_INDEX = 0x00; // 00xxxxxx
+constexpr std::uint8_t OP_DIFF = 0x40;  // 01xxxxxx
+constexpr std::uint8_t OP_LUMA = 0x80;  // 10xxxxxx
+constexpr std::uint8_t OP_RUN = 0xc0;   // 11xxxxxx
+constexpr std::uint8_t OP_RGB = 0xfe;
+constexpr std::uint8_t OP_RGBA = 0xff;
+constexpr std::uint8_t MASK_2 = 0xc0;
+constexpr int MAX_RUN = 62;
+constexpr std::uint8_t END_MARKER[qoi::PADDING_SIZE] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+struct Rgba {
+    std::uint8_t r, g, b, a;
+    bool operator==(const Rgba& o) const { return r == o.r && g == o.g && b == o.b && a == o.a; }
+};
+
+inline int hash(const Rgba& px) { return (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64; }
+
+// Vị trí bit của từng kênh trong một pixel Uint32 của định dạng 8888
+struct Shifts { int r, g, b, a; };
+
+bool shiftsFor(Uint32 format, Shifts& out) {
+    switch (format) {
+        case SDL_PIXELFORMAT_ARGB8888: out = Shifts{ 16, 8, 0, 24 }; return true;
+        case SDL_PIXELFORMAT_RGBA8888: out = Shifts{ 24, 16, 8, 0 }; return true;
+        case SDL_PIXELFORMAT_ABGR8888: out = Shifts{ 0, 8, 16, 24 }; return true;
+        case SDL_PIXELFORMAT_BGRA8888: out = Shifts{ 8, 16, 24, 0 }; return true;
+        default: return false;
+    }
+}
+
+inline std::uint32_t readBigEndian32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) << 24 | static_cast<std::uint32_t>(p[1]) << 16 | static_cast<std::uint32_t>(p[2]) << 8 | p[3];
+}
+
+inline void writeBigEndian32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    out.push_back(static_cast<std::uint8_t>(v >> 24));
+    out.push_back(static_cast<std::uint8_t>(v >> 16));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+} // namespace
+
+namespace qoi {
+
+bool supportsFormat(Uint32 format) {
+    Shifts shifts;
+    return shiftsFor(format, shifts);
+}
+
+SDL_Surface* decode(const void* data, std::size_t size, Uint32 format) {
+    Shifts shifts;
+    if (!shiftsFor(format, shifts)) { SDL_SetError("QOI: unsupported target pixel format"); return nullptr; }
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    if (!bytes || size < HEADER_SIZE + PADDING_SIZE || std::memcmp(bytes, "qoif", 4) != 0) { SDL_SetError("QOI: not a QOI file"); return nullptr; }
+    const std::uint32_t width = readBigEndian32(bytes + 4), height = readBigEndian32(bytes + 8);
+    const std::uint8_t channels = bytes[12], colorspace = bytes[13];
+    if (width == 0 || height == 0 || width > 0x7fffffff || height > 0x7fffffff ||
+        static_cast<std::uint64_t>(width) * height > MAX_PIXELS || (channels != 3 && channels != 4) || colorspace > 1) {
+        SDL_SetError("QOI: invalid header");
+        return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(width), static_cast<int>(height), 32, format);
+    if (!surface) return nullptr;
+
+    Rgba index[64];
+    std::memset(index, 0, sizeof(index));
+    Rgba px = { 0, 0, 0, 255 };
+    int run = 0;
+    // Đệm 8 byte cuối file bảo đảm đọc tối đa 5 byte của một chunk không vượt ra ngoài data
+    std::size_t p = HEADER_SIZE;
+    const std::size_t chunksEnd = size - PADDING_SIZE;
+    std::uint8_t* row = static_cast<std::uint8_t*>(surface->pixels);
+    for (std::uint32_t y = 0; y < height; ++y, row += surface->pitch) {
+        std::uint32_t* out = reinterpret_cast<std::uint32_t*>(row);
+        for (std::uint32_t x = 0; x < width; ++x) {
+            if (run > 0) {
+                --run;
+            } else if (p < chunksEnd) {
+                const std::uint8_t b1 = bytes[p++];
+                if (b1 == OP_RGB) {
+                    px.r = bytes[p]; px.g = bytes[p + 1]; px.b = bytes[p + 2];
+                    p += 3;
+                } else if (b1 == OP_RGBA) {
+                    px.r = bytes[p]; px.g = bytes[p + 1]; px.b = bytes[p + 2]; px.a = bytes[p + 3];
+                    p += 4;
+                } else if ((b1 & MASK_2) == OP_INDEX) {
+                    px = index[b1];
+                } else if ((b1 & MASK_2) == OP_DIFF) {
+                    px.r += ((b1 >> 4) & 0x03) - 2;
+                    px.g += ((b1 >> 2) & 0x03) - 2;
+                    px.b += (b1 & 0x03) - 2;
+                } else if ((b1 & MASK_2) == OP_LUMA) {
+                    const std::uint8_t b2 = bytes[p++];
+                    const int vg = (b1 & 0x3f) - 32;
+                    px.r += vg - 8 + ((b2 >> 4) & 0x0f);
+                    px.g += vg;
+                    px.b += vg - 8 + (b2 & 0x0f);
+                } else {
+                    run = b1 & 0x3f;
+                }
+                index[hash(px)] = px;
+            }
+            out[x] = static_cast<std::uint32_t>(px.r) << shifts.r | static_cast<std::uint32_t>(px.g) << shifts.g |
+                     static_cast<std::uint32_t>(px.b) << shifts.b | static_cast<std::uint32_t>(px.a) << shifts.a;
+        }
+    }
+    return surface;
+}
+
+SDL_Surface* load(const std::string& path, Uint32 format) {
+    std::size_t size = 0;
+    void* data = SDL_LoadFile(path.c_str(), &size);
+    if (!data) return nullptr;
+    SDL_Surface* surface = decode(data, size, format);
+    SDL_free(data);
+    return surface;
+}
+
+bool encode(SDL_Surface* surface, std::vector<std::uint8_t>& out) {
+    if (!surface) return false;
+    // RGBA32 có thứ tự byte r, g, b, a trong bộ nhớ trên mọi nền tảng
+    SDL_Surface* rgba = surface->format->format == SDL_PIXELFORMAT_RGBA32 ? surface : SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) return false;
+
+    bool opaque = true;
+    for (int y = 0; y < rgba->h && opaque; ++y) {
+        const std::uint8_t* row = static_cast<const std::uint8_t*>(rgba->pixels) + y * rgba->pitch;
+        for (int x = 0; x < rgba->w; ++x) if (row[x * 4 + 3] != 255) { opaque = false; break; }
+    }
+
+    out.clear();
+    out.reserve(HEADER_SIZE + static_cast<std::size_t>(rgba->w) * rgba->h + PADDING_SIZE);
+    out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+    writeBigEndian32(out, static_cast<std::uint32_t>(rgba->w));
+    writeBigEndian32(out, static_cast<std::uint32_t>(rgba->h));
+    out.push_back(opaque ? 3 : 4);
+    out.push_back(0); // sRGB, alpha tuyến tính
+
+    Rgba index[64];
+    std::memset(index, 0, sizeof(index));
+    Rgba prev = { 0, 0, 0, 255 };
+    int run = 0;
+    const long long total = static_cast<long long>(rgba->w) * rgba->h;
+    long long position = 0;
+    for (int y = 0; y < rgba->h; ++y) {
+        const std::uint8_t* row = static_cast<const std::uint8_t*>(rgba->pixels) + y * rgba->pitch;
+        for (int x = 0; x < rgba->w; ++x, ++position) {
+            const Rgba px = { row[x * 4], row[x * 4 + 1], row[x * 4 + 2], row[x * 4 + 3] };
+            if (px == prev) {
+                if (++run == MAX_RUN || position == total - 1) { out.push_back(static_cast<std::uint8_t>(OP_RUN | (run - 1))); run = 0; }
+                continue;
+            }
+            if (run > 0) { out.push_back(static_cast<std::uint8_t>(OP_RUN | (run - 1))); run = 0; }
+
+            const int slot = hash(px);
+            if (index[slot] == px) {
+                out.push_back(static_cast<std::uint8_t>(OP_INDEX | slot));
+            } else {
+                index[slot] = px;
+                if (px.a == prev.a) {
+                    // Chênh lệch tính theo byte có dấu (quay vòng), như đặc tả
+                    const int vr = static_cast<std::int8_t>(px.r - prev.r);
+                    const int vg = static_cast<std::int8_t>(px.g - prev.g);
+                    const int vb = static_cast<std::int8_t>(px.b - prev.b);
+                    const int vgr = vr - vg, vgb = vb - vg;
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                        out.push_back(static_cast<std::uint8_t>(OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+                    } else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8) {
+                        out.push_back(static_cast<std::uint8_t>(OP_LUMA | (vg + 32)));
+                        out.push_back(static_cast<std::uint8_t>((vgr + 8) << 4 | (vgb + 8)));
+                    } else {
+                        out.insert(out.end(), { OP_RGB, px.r, px.g, px.b });
+                    }
+                } else {
+                    out.insert(out.end(), { OP_RGBA, px.r, px.g, px.b, px.a });
+                }
+            }
+            prev = px;
+        }
+    }
+    out.insert(out.end(), END_MARKER, END_MARKER + PADDING_SIZE);
+    if (rgba != surface) SDL_FreeSurface(rgba);
+    return true;
+}
+
+Uint32 preferredFormat(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    if (renderer && SDL_GetRendererInfo(renderer, &info) == 0) {
+        for (Uint32 i = 0; i < info.num_texture_formats; ++i)
+            if (supportsFormat(info.texture_formats[i])) return info.texture_formats[i];
+    }
+    return SDL_PIXELFORMAT_RGBA32;
+}
+
+std::string siblingPath(const std::string& path) {
+    return std::filesystem::path(path).replace_extension(".qoi").string();
+}
+
+SDL_Surface* loadPreferred(const std::string& path, Uint32 format) {
+    namespace fs = std::filesystem;
+    const std::string sibling = siblingPath(path);
+    std::error_code error;
+    fs::file_time_type qoiTime = fs::last_write_time(sibling, error);
+    bool useQoi = !error;
+    if (useQoi && sibling != path) {
+        // Ảnh gốc vừa sửa (hot reload) mà chưa chạy lại contra_qoi thì dùng ảnh gốc
+        fs::file_time_type sourceTime = fs::last_write_time(path, error);
+        useQoi = error || qoiTime >= sourceTime;
+    }
+    if (useQoi) {
+        // Định dạng decoder không ghi được thì giải mã RGBA32 rồi đổi
+        Uint32 decodeFormat = supportsFormat(format) ? format : SDL_PIXELFORMAT_RGBA32;
+        SDL_Surface* decoded = load(sibling, decodeFormat);
+        if (decoded && decodeFormat != format) {
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(decoded, format, 0);
+            SDL_FreeSurface(decoded);
+            decoded = converted;
+        }
+        if (decoded || sibling == path) return decoded;
+    }
+
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded || loaded->format->format == format) return loaded;
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, format, 0);
+    SDL_FreeSurface(loaded);
+    return converted;
+}
+
+} // namespace qoi
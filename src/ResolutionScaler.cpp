@@ -0,0 +1,26 @@
+#include "ResolutionScaler.hpp"
+#include <iostream>
+
+ResolutionScaler::ResolutionScaler(double p_budgetSeconds)
+    : budget(p_budgetSeconds), average(0.0), level(0), framesOver(0), framesUnder(0), cooldown(0)
+{
+}
+
+float ResolutionScaler::update(double renderSeconds) {
+    average = average > 0.0 ? average + (renderSeconds - average) * SMOOTHING : renderSeconds;
+    if (cooldown > 0) { --cooldown; return getScale(); }
+
+    framesOver = average > budget ? framesOver + 1 : 0;
+    framesUnder = average < budget * UP_RATIO ? framesUnder + 1 : 0;
+
+    int next = level;
+    if (framesOver >= DOWN_FRAMES && level + 1 < LEVEL_COUNT) next = level + 1;
+    else if (framesUnder >= UP_FRAMES && level > 0) next = level - 1;
+    if (next != level) {
+        level = next;
+        framesOver = framesUnder = 0;
+        cooldown = COOLDOWN_FRAMES;
+        std::cout << "Render scale: " << getScale() << " (avg " << average * 1000.0 << " ms)" << std::endl;
+    }
+    return getScale();
+}
@@ -0,0 +1,148 @@
+#include "SimThread.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+SimThread* SimThread::soundTarget = nullptr;
+
+SimThread::SimThread(World& p_world, Player& p_player, float p_timeStep, int p_screenWidth, float p_cameraMaxX, bool p_threaded)
+    : world(p_world), player(p_player), timeStep(p_timeStep), screenWidth(p_screenWidth), cameraMaxX(p_cameraMaxX), threaded(p_threaded),
+      quit(false), running(false), paused(false), session(0), ticks(0), lastTime(0.0), accumulator(0.0)
+{
+    std::memset(keyStates, 0, sizeof(keyStates));
+    world.player = &player;
+}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+double SimThread::clockSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+void SimThread::start() {
+    soundTarget = this;
+    sfx::setHandler(queueSound);
+    lastTime = clockSeconds();
+    if (threaded && !thread.joinable()) {
+        quit.store(false, std::memory_order_relaxed);
+        thread = std::thread(&SimThread::run, this);
+    }
+}
+
+void SimThread::stop() {
+    quit.store(true, std::memory_order_release);
+    if (thread.joinable()) thread.join();
+    if (soundTarget == this) { sfx::setHandler(nullptr); soundTarget = nullptr; }
+}
+
+void SimThread::pump() {
+    if (threaded) return;
+    drainInputs();
+    advance(clockSeconds());
+}
+
+// Đầy hàng đợi thì bỏ âm thanh: main thread không kịp đọc thì phát muộn cũng vô nghĩa
+void SimThread::queueSound(SoundEffect effect, float x) {
+    if (soundTarget) soundTarget->events.push(SimEvent{ SimEvent::Type::SOUND, static_cast<std::int32_t>(effect), x, soundTarget->ticks });
+}
+
+// --- Thread mô phỏng ---
+void SimThread::run() {
+    while (!quit.load(std::memory_order_acquire)) {
+        drainInputs();
+        advance(clockSeconds());
+        // Ngủ tới lúc tick kế tiếp đến hạn; lệnh mới chờ tối đa một tick
+        double wait = (running && !paused) ? timeStep - accumulator : timeStep;
+        std::this_thread::sleep_for(std::chrono::duration<double>(std::max(wait, 0.0)));
+    }
+}
+
+void SimThread::drainInputs() {
+    SimInput input;
+    while (inputs.pop(input)) {
+        switch (input.type) {
+            case SimInput::Type::START: {
+                player.resetPlayerStateForNewGame();
+                player.setPos(vector2d{ World::PLAYER_START_X, World::PLAYER_START_Y });
+                player.setInvulnerable(false);
+                world.reset();
+                std::memset(keyStates, 0, sizeof(keyStates));
+                session = static_cast<std::uint32_t>(input.value);
+                running = true; paused = false;
+                accumulator = 0.0;
+                lastTime = clockSeconds();
+                std::cout << "Game Initialized. Spawned " << world.enemies.size() << " troops and " << world.turrets.size() << " turrets." << std::endl;
+                publish(lastTime); // Main thread thấy ngay màn mới thay vì snapshot của lượt trước
+            } break;
+            case SimInput::Type::PAUSE: paused = true; break;
+            case SimInput::Type::RESUME: paused = false; break;
+            case SimInput::Type::KEYS: {
+                std::uint32_t mask = static_cast<std::uint32_t>(input.value);
+                keyStates[SDL_SCANCODE_LEFT] = (mask & SimInput::KEY_LEFT) != 0;
+                keyStates[SDL_SCANCODE_RIGHT] = (mask & SimInput::KEY_RIGHT) != 0;
+                keyStates[SDL_SCANCODE_UP] = (mask & SimInput::KEY_UP) != 0;
+                keyStates[SDL_SCANCODE_DOWN] = (mask & SimInput::KEY_DOWN) != 0;
+                keyStates[SDL_SCANCODE_F] = (mask & SimInput::KEY_SHOOT) != 0;
+            } break;
+            case SimInput::Type::KEY_DOWN:
+                if (running && !paused) player.handleKeyDown(static_cast<SDL_Keycode>(input.value));
+                break;
+        }
+    }
+}
+
+void SimThread::advance(double now) {
+    double frameTime = std::min(now - lastTime, MAX_FRAME_SECONDS);
+    lastTime = now;
+    if (!running || paused) return;
+
+    accumulator += frameTime;
+    while (accumulator >= timeStep) {
+        accumulator -= timeStep;
+        if (tick(now - accumulator)) break;
+    }
+}
+
+// Một tick trọn vẹn như headless: input, step, dọn entity, thắng/thua, bắn, camera
+bool SimThread::tick(double dueTime) {
+    player.handleInput(keyStates);
+    world.step(timeStep);
+    world.removeDead();
+
+    WorldEvent worldEvent = world.checkProgress();
+    world.firePlayerBullets();
+    world.followCamera(screenWidth);
+    world.cameraX = cameraMaxX > 0.0f ? utils::clamp(world.cameraX, 0.0f, cameraMaxX) : 0.0f;
+    publish(dueTime);
+
+    if (worldEvent == WorldEvent::NONE) return false;
+    running = false;
+    SimEvent::Type type = worldEvent == WorldEvent::PLAYER_REACHED_GOAL ? SimEvent::Type::WON : SimEvent::Type::GAME_OVER;
+    // Sự kiện kết thúc không được rơi: hàng đợi đầy thì chờ main thread đọc bớt (không thread thì main đã đọc hết mỗi frame)
+    while (!events.push(SimEvent{ type, world.score }) && threaded && !quit.load(std::memory_order_acquire)) std::this_thread::yield();
+    return true;
+}
+
+void SimThread::publish(double tickTime) {
+    RenderSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.clear();
+    float minX = world.cameraX - VIEW_MARGIN, maxX = world.cameraX + screenWidth + VIEW_MARGIN;
+    world.enemies.collect(snapshot, minX, maxX);
+    world.turrets.collect(snapshot, minX, maxX);
+    world.playerBullets.collect(snapshot, minX, maxX);
+    world.enemyBullets.collect(snapshot, minX, maxX);
+    player.collect(snapshot);
+
+    snapshot.prevCameraX = world.prevCameraX; snapshot.prevCameraY = world.prevCameraY;
+    snapshot.cameraX = world.cameraX; snapshot.cameraY = world.cameraY;
+    snapshot.score = world.score;
+    snapshot.lives = player.getLives();
+    snapshot.session = session;
+    snapshot.tick = ++ticks;
+    snapshot.tickTime = tickTime;
+    snapshots.publish();
+}
@@ -0,0 +1,45 @@
+#include "SpatialHash.hpp"
+#include <algorithm>
+
+SpatialHash::SpatialHash(int p_cellSize)
+    : cellSize(std::max(1, p_cellSize)), bucketMask(0)
+{
+}
+
+void SpatialHash::clear() {
+    entries.clear();
+    ids.clear();
+    rects.clear();
+}
+
+void SpatialHash::insert(int id, const SDL_Rect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    int r = static_cast<int>(rects.size());
+    rects.push_back(rect);
+    int cx0 = cellCoord(rect.x), cx1 = cellCoord(rect.x + rect.w - 1);
+    int cy0 = cellCoord(rect.y), cy1 = cellCoord(rect.y + rect.h - 1);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) entries.push_back(Entry{id, cx, cy, r});
+    }
+}
+
+void SpatialHash::build() {
+    // Số bucket là lũy thừa của 2, gấp đôi số entry để ít trùng
+    std::uint32_t bucketCount = 16;
+    while (bucketCount < entries.size() * 2) bucketCount <<= 1;
+    bucketMask = bucketCount - 1;
+
+    // Counting sort theo bucket
+    bucketStart.assign(bucketCount + 1, 0);
+    for (const Entry& e : entries) bucketStart[bucketOf(e.cx, e.cy) + 1]++;
+    for (std::uint32_t b = 0; b < bucketCount; ++b) bucketStart[b + 1] += bucketStart[b];
+
+    cursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    ids.resize(entries.size());
+    boxes.resize(entries.size());
+    for (const Entry& e : entries) {
+        int k = cursor[bucketOf(e.cx, e.cy)]++;
+        ids[k] = e.id;
+        boxes.set(static_cast<std::size_t>(k), aabb::fromRect(rects[e.rect]));
+    }
+}
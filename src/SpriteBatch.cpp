@@ -0,0 +1,66 @@
+#include "SpriteBatch.hpp"
+#include <algorithm>
+#include <iostream>
+
+std::uint32_t SpriteBatch::textureIndex(SDL_Texture* tex) {
+    for (std::size_t i = 0; i < textures.size(); ++i)
+        if (textures[i].tex == tex) return static_cast<std::uint32_t>(i);
+    int w = 0, h = 0;
+    SDL_QueryTexture(tex, NULL, NULL, &w, &h);
+    textures.push_back(TextureInfo{ tex, w > 0 ? 1.0f / w : 0.0f, h > 0 ? 1.0f / h : 0.0f });
+    return static_cast<std::uint32_t>(textures.size() - 1);
+}
+
+void SpriteBatch::draw(SDL_Texture* tex, const SDL_Rect& src, const SDL_Rect& dst, bool flipH, std::uint8_t layer, SDL_Color color) {
+    if (!tex) return;
+    std::uint64_t key = (static_cast<std::uint64_t>(layer) << 56)
+                      | (static_cast<std::uint64_t>(textureIndex(tex) & 0xFFFFFF) << 32)
+                      | static_cast<std::uint32_t>(quads.size());
+    quads.push_back(Quad{ key, tex, src, dst, flipH, color });
+}
+
+void SpriteBatch::flush(SDL_Renderer* renderer) {
+    drawCalls = 0;
+    if (quads.empty()) { textures.clear(); return; }
+
+    std::sort(quads.begin(), quads.end(), [](const Quad& a, const Quad& b) { return a.key < b.key; });
+
+    vertices.resize(quads.size() * 4);
+    for (std::size_t q = indices.size() / 6; q < quads.size(); ++q) {
+        int v = static_cast<int>(q * 4);
+        indices.insert(indices.end(), { v, v + 1, v + 2, v + 2, v + 3, v });
+    }
+
+    for (std::size_t q = 0; q < quads.size(); ++q) {
+        const Quad& quad = quads[q];
+        const TextureInfo& info = textures[(quad.key >> 32) & 0xFFFFFF];
+
+        float x0 = static_cast<float>(quad.dst.x), x1 = static_cast<float>(quad.dst.x + quad.dst.w);
+        float y0 = static_cast<float>(quad.dst.y), y1 = static_cast<float>(quad.dst.y + quad.dst.h);
+        float u0 = quad.src.x * info.invW, u1 = (quad.src.x + quad.src.w) * info.invW;
+        float v0 = quad.src.y * info.invH, v1 = (quad.src.y + quad.src.h) * info.invH;
+        if (quad.flipH) std::swap(u0, u1);
+
+        SDL_Vertex* out = &vertices[q * 4];
+        out[0] = SDL_Vertex{ SDL_FPoint{ x0, y0 }, quad.color, SDL_FPoint{ u0, v0 } };
+        out[1] = SDL_Vertex{ SDL_FPoint{ x1, y0 }, quad.color, SDL_FPoint{ u1, v0 } };
+        out[2] = SDL_Vertex{ SDL_FPoint{ x1, y1 }, quad.color, SDL_FPoint{ u1, v1 } };
+        out[3] = SDL_Vertex{ SDL_FPoint{ x0, y1 }, quad.color, SDL_FPoint{ u0, v1 } };
+    }
+
+    // Dãy quad liên tiếp cùng texture (kể cả khi vượt qua ranh giới layer) là một lệnh vẽ:
+    // thứ tự vertex trong lệnh đã đúng thứ tự layer nên không đổi kết quả chồng hình
+    std::size_t runStart = 0;
+    for (std::size_t q = 1; q <= quads.size(); ++q) {
+        if (q < quads.size() && quads[q].tex == quads[runStart].tex) continue;
+        int count = static_cast<int>(q - runStart);
+        // Index của quad thứ k trong dãy là 4k.., nên dùng lại phần đầu bảng index với vertex dời tới runStart
+        if (SDL_RenderGeometry(renderer, quads[runStart].tex, &vertices[runStart * 4], count * 4, indices.data(), count * 6) != 0)
+            std::cerr << "SDL_RenderGeometry failed: " << SDL_GetError() << std::endl;
+        ++drawCalls;
+        runStart = q;
+    }
+
+    quads.clear();
+    textures.clear();
+}
@@ -0,0 +1,109 @@
+#include "TextRenderer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    constexpr int GLYPHS_PER_ROW = 16;
+    const SDL_Color GLYPH_COLOR = { 255, 255, 255, 255 }; // Atlas trắng, màu thật lấy từ vertex
+}
+
+TextRenderer::TextRenderer(SDL_Renderer* p_renderer, TTF_Font* p_font)
+    : renderer(p_renderer), font(p_font), atlas(nullptr), height(0), glyphs{}
+{
+    if (!font) return;
+    height = TTF_FontHeight(font);
+
+    // Rasterize từng glyph trước để biết ô lớn nhất, rồi xếp thành lưới GLYPHS_PER_ROW cột
+    const int glyphCount = LAST_GLYPH - FIRST_GLYPH + 1;
+    SDL_Surface* rendered[glyphCount] = {};
+    int cellW = 1, cellH = std::max(1, height);
+    for (int i = 0; i < glyphCount; ++i) {
+        Uint16 ch = static_cast<Uint16>(FIRST_GLYPH + i);
+        int minX, maxX, minY, maxY, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY, &advance) == 0) glyphs[i].advance = advance;
+        if (ch == ' ') continue;
+        rendered[i] = TTF_RenderGlyph_Solid(font, ch, GLYPH_COLOR);
+        if (!rendered[i]) continue;
+        cellW = std::max(cellW, rendered[i]->w);
+        cellH = std::max(cellH, rendered[i]->h);
+    }
+
+    const int rows = (glyphCount + GLYPHS_PER_ROW - 1) / GLYPHS_PER_ROW;
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, GLYPHS_PER_ROW * (cellW + 1), rows * (cellH + 1), 32, SDL_PIXELFORMAT_RGBA32);
+    if (!sheet) std::cout << "Failed to create glyph atlas. Error: " << SDL_GetError() << std::endl;
+    for (int i = 0; i < glyphCount; ++i) {
+        if (!rendered[i]) continue;
+        if (sheet) {
+            SDL_Rect dst = { (i % GLYPHS_PER_ROW) * (cellW + 1), (i / GLYPHS_PER_ROW) * (cellH + 1), rendered[i]->w, rendered[i]->h };
+            SDL_BlitSurface(rendered[i], NULL, sheet, &dst); // Surface Solid dùng colorkey: nền giữ trong suốt
+            glyphs[i].src = dst;
+        }
+        SDL_FreeSurface(rendered[i]);
+    }
+    if (!sheet) return;
+
+    atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+    SDL_FreeSurface(sheet);
+    if (!atlas) {
+        std::cout << "Failed to upload glyph atlas. Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+}
+
+TextRenderer::~TextRenderer() {
+    for (StaticText& s : statics) SDL_DestroyTexture(s.texture);
+    SDL_DestroyTexture(atlas);
+}
+
+int TextRenderer::measure(const char* text) const {
+    int w = 0;
+    for (const char* p = text; *p; ++p) {
+        int c = static_cast<unsigned char>(*p);
+        if (c >= FIRST_GLYPH && c <= LAST_GLYPH) w += glyphs[c - FIRST_GLYPH].advance;
+    }
+    return w;
+}
+
+int TextRenderer::draw(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color, std::uint8_t layer) const {
+    if (!atlas) return 0;
+    int penX = x;
+    for (const char* p = text; *p; ++p) {
+        int c = static_cast<unsigned char>(*p);
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) continue;
+        const Glyph& g = glyphs[c - FIRST_GLYPH];
+        if (g.src.w > 0) batch.draw(atlas, g.src, SDL_Rect{ penX, y, g.src.w, g.src.h }, false, layer, color);
+        penX += g.advance;
+    }
+    return penX - x;
+}
+
+const TextRenderer::StaticText* TextRenderer::findOrCreateStatic(const char* text, SDL_Color color) {
+    for (const StaticText& s : statics) {
+        if (s.color.r == color.r && s.color.g == color.g && s.color.b == color.b && s.color.a == color.a && s.text == text)
+            return &s;
+    }
+    if (!font) return nullptr;
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text, color);
+    if (!surface) return nullptr;
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    StaticText entry{ text, color, texture, surface->w, surface->h };
+    SDL_FreeSurface(surface);
+    if (!texture) return nullptr;
+    statics.push_back(entry);
+    return &statics.back();
+}
+
+SDL_Point TextRenderer::staticSize(const char* text, SDL_Color color) {
+    const StaticText* s = findOrCreateStatic(text, color);
+    return s ? SDL_Point{ s->w, s->h } : SDL_Point{ 0, 0 };
+}
+
+SDL_Point TextRenderer::drawStatic(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color, std::uint8_t layer) {
+    const StaticText* s = findOrCreateStatic(text, color);
+    if (!s) return SDL_Point{ 0, 0 };
+    batch.draw(s->texture, SDL_Rect{ 0, 0, s->w, s->h }, SDL_Rect{ x, y, s->w, s->h }, false, layer);
+    return SDL_Point{ s->w, s->h };
+}
@@ -0,0 +1,306 @@
+#include "TextureAtlas.hpp"
+#include "AssetLoader.hpp"
+#include "Qoi.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // Đường chân trời của một trang: các đoạn ngang liền nhau phủ [0, size), y là đáy phần đã dùng
+    // phía trên đoạn đó. Ô mới đặt ở vị trí có đáy thấp nhất (hòa thì lấy x nhỏ nhất).
+    class Skyline {
+    public:
+        explicit Skyline(int p_size) : size(p_size) { if (size > 0) nodes.push_back(Node{ 0, 0, size }); }
+
+        bool insert(int w, int h, SDL_Point& out) {
+            std::size_t bestIndex = nodes.size();
+            int bestBottom = INT_MAX, bestX = 0, bestY = 0;
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                int y;
+                if (!fits(i, w, h, y)) continue;
+                if (y + h < bestBottom || (y + h == bestBottom && nodes[i].x < bestX)) {
+                    bestIndex = i; bestBottom = y + h; bestX = nodes[i].x; bestY = y;
+                }
+            }
+            if (bestIndex == nodes.size()) return false;
+            place(bestIndex, bestX, bestBottom, w);
+            out = SDL_Point{ bestX, bestY };
+            return true;
+        }
+
+        int usedHeight() const {
+            int h = 0;
+            for (const Node& n : nodes) h = std::max(h, n.y);
+            return h;
+        }
+
+    private:
+        struct Node { int x, y, w; };
+        int size;
+        std::vector<Node> nodes;
+
+        // Ô w×h đặt tại đầu đoạn i thì nằm trên đoạn cao nhất mà nó phủ
+        bool fits(std::size_t i, int w, int h, int& outY) const {
+            const int end = nodes[i].x + w;
+            if (end > size) return false;
+            int y = 0;
+            for (std::size_t j = i; j < nodes.size() && nodes[j].x < end; ++j) {
+                y = std::max(y, nodes[j].y);
+                if (y + h > size) return false;
+            }
+            outY = y;
+            return true;
+        }
+
+        void place(std::size_t i, int x, int bottom, int w) {
+            nodes.insert(nodes.begin() + i, Node{ x, bottom, w });
+            // Cắt các đoạn phía sau bị ô mới che
+            const int end = x + w;
+            for (std::size_t j = i + 1; j < nodes.size() && nodes[j].x < end;) {
+                int covered = end - nodes[j].x;
+                if (nodes[j].w <= covered) { nodes.erase(nodes.begin() + j); continue; }
+                nodes[j].x += covered; nodes[j].w -= covered;
+                break;
+            }
+            // Gộp các đoạn kề nhau cùng độ cao
+            for (std::size_t j = 0; j + 1 < nodes.size();) {
+                if (nodes[j].y == nodes[j + 1].y) { nodes[j].w += nodes[j + 1].w; nodes.erase(nodes.begin() + j + 1); }
+                else ++j;
+            }
+        }
+    };
+
+    std::uint64_t hashPixels(const SDL_Surface* s) {
+        std::uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](const unsigned char* p, std::size_t n) {
+            for (std::size_t k = 0; k < n; ++k) { h ^= p[k]; h *= 1099511628211ull; }
+        };
+        mix(reinterpret_cast<const unsigned char*>(&s->w), sizeof(s->w));
+        mix(reinterpret_cast<const unsigned char*>(&s->h), sizeof(s->h));
+        for (int y = 0; y < s->h; ++y)
+            mix(static_cast<const unsigned char*>(s->pixels) + y * s->pitch, static_cast<std::size_t>(s->w) * 4);
+        return h;
+    }
+
+    bool samePixels(const SDL_Surface* a, const SDL_Surface* b) {
+        if (a->w != b->w || a->h != b->h) return false;
+        for (int y = 0; y < a->h; ++y) {
+            if (std::memcmp(static_cast<const unsigned char*>(a->pixels) + y * a->pitch,
+                            static_cast<const unsigned char*>(b->pixels) + y * b->pitch,
+                            static_cast<std::size_t>(a->w) * 4) != 0) return false;
+        }
+        return true;
+    }
+}
+
+TextureAtlas::TextureAtlas(SDL_Renderer* p_renderer, int p_pageSize)
+    : renderer(p_renderer), pageSize(p_pageSize), built(false), deduplicate(true), loader(nullptr)
+{}
+
+TextureAtlas::~TextureAtlas() {
+    for (Image& img : images) SDL_FreeSurface(img.surface);
+    for (SDL_Texture* page : pages) SDL_DestroyTexture(page);
+}
+
+int TextureAtlas::add(const std::string& p_filePath) {
+    if (built) {
+        std::cout << "Atlas already built, cannot add " << p_filePath << std::endl;
+        return -1;
+    }
+    for (std::size_t i = 0; i < images.size(); ++i)
+        if (images[i].path == p_filePath) return static_cast<int>(i);
+
+    SDL_Surface* loaded = qoi::loadPreferred(p_filePath, SDL_PIXELFORMAT_RGBA32);
+    if (!loaded) {
+        std::cout << "Failed to load texture. Error: " << SDL_GetError() << std::endl;
+        return -1;
+    }
+    return add(p_filePath, loaded);
+}
+
+int TextureAtlas::add(const std::string& p_filePath, SDL_Surface* p_surface) {
+    if (!p_surface) return -1;
+    if (built) {
+        std::cout << "Atlas already built, cannot add " << p_filePath << std::endl;
+        SDL_FreeSurface(p_surface);
+        return -1;
+    }
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        if (images[i].path == p_filePath) { SDL_FreeSurface(p_surface); return static_cast<int>(i); }
+    }
+
+    // Đưa mọi ảnh về RGBA32 để so sánh pixel và blit sang trang không phải đổi định dạng
+    SDL_Surface* surface = p_surface;
+    if (p_surface->format->format != SDL_PIXELFORMAT_RGBA32) {
+        surface = SDL_ConvertSurfaceFormat(p_surface, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(p_surface);
+        if (!surface) {
+            std::cout << "Failed to convert " << p_filePath << ". Error: " << SDL_GetError() << std::endl;
+            return -1;
+        }
+    }
+
+    std::uint64_t hash = hashPixels(surface);
+    for (std::size_t i = 0; deduplicate && i < images.size(); ++i) {
+        if (images[i].surface && images[i].hash == hash && samePixels(images[i].surface, surface)) {
+            SDL_FreeSurface(surface); // File khác tên nhưng cùng nội dung: dùng lại ô cũ
+            return static_cast<int>(i);
+        }
+    }
+    images.push_back(Image{ p_filePath, surface, hash, -1, SDL_Rect{ 0, 0, surface->w, surface->h }, -1, -1 });
+    return static_cast<int>(images.size() - 1);
+}
+
+int TextureAtlas::add(const std::string& p_filePath, AssetLoader& p_loader) {
+    if (built) {
+        std::cout << "Atlas already built, cannot add " << p_filePath << std::endl;
+        return -1;
+    }
+    for (std::size_t i = 0; i < images.size(); ++i)
+        if (images[i].path == p_filePath) return static_cast<int>(i);
+
+    loader = &p_loader;
+    images.push_back(Image{ p_filePath, nullptr, 0, -1, SDL_Rect{ 0, 0, 0, 0 }, p_loader.loadImage(p_filePath), -1 });
+    return static_cast<int>(images.size() - 1);
+}
+
+// Lấy surface của các ảnh add bất đồng bộ. Cùng nội dung với ảnh trước đó thì thành alias của ảnh đó.
+void TextureAtlas::resolvePending() {
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        Image& img = images[i];
+        if (img.job < 0) continue;
+        img.surface = loader->takeSurface(img.job);
+        img.job = -1;
+        if (!img.surface) continue;
+        img.rect = SDL_Rect{ 0, 0, img.surface->w, img.surface->h };
+        img.hash = hashPixels(img.surface);
+        for (std::size_t j = 0; deduplicate && j < i; ++j) {
+            if (images[j].alias < 0 && images[j].surface && images[j].hash == img.hash && samePixels(images[j].surface, img.surface)) {
+                img.alias = static_cast<int>(j);
+                SDL_FreeSurface(img.surface);
+                img.surface = nullptr;
+                break;
+            }
+        }
+    }
+}
+
+bool TextureAtlas::build() {
+    if (built) return !pages.empty() || images.empty();
+    built = true;
+    if (loader) resolvePending();
+
+    // Chỉ xếp ảnh có pixel và không phải alias
+    std::vector<std::size_t> order;
+    bool missing = false;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        if (images[i].surface) order.push_back(i);
+        else if (images[i].alias < 0) missing = true;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        if (images[a].rect.h != images[b].rect.h) return images[a].rect.h > images[b].rect.h;
+        return images[a].rect.w > images[b].rect.w;
+    });
+
+    // Trang ảo rộng thêm PADDING để viền đệm của ô sát mép phải/dưới được phép nằm ngoài trang
+    std::vector<Skyline> skylines;
+    std::vector<SDL_Point> pageDims;
+    for (std::size_t idx : order) {
+        Image& img = images[idx];
+        SDL_Point at = { 0, 0 };
+        if (img.rect.w > pageSize || img.rect.h > pageSize) {
+            // Ảnh lớn hơn trang: trang riêng đúng kích thước ảnh
+            skylines.emplace_back(0);
+            pageDims.push_back(SDL_Point{ img.rect.w, img.rect.h });
+            img.page = static_cast<int>(skylines.size() - 1);
+        } else {
+            for (std::size_t p = 0; p < skylines.size() && img.page < 0; ++p)
+                if (skylines[p].insert(img.rect.w + PADDING, img.rect.h + PADDING, at)) img.page = static_cast<int>(p);
+            if (img.page < 0) {
+                skylines.emplace_back(pageSize + PADDING);
+                pageDims.push_back(SDL_Point{ pageSize, pageSize });
+                skylines.back().insert(img.rect.w + PADDING, img.rect.h + PADDING, at);
+                img.page = static_cast<int>(skylines.size() - 1);
+            }
+        }
+        img.rect.x = at.x;
+        img.rect.y = at.y;
+    }
+
+    // Cắt phần dưới chưa dùng của trang thường: sprite hiện tại chỉ chiếm khoảng một phần tư trang
+    for (std::size_t p = 0; p < pageDims.size(); ++p)
+        if (skylines[p].usedHeight() > 0) pageDims[p].y = std::min(pageSize, skylines[p].usedHeight());
+
+    bool ok = true;
+    for (std::size_t p = 0; p < pageDims.size(); ++p) {
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pageDims[p].x, pageDims[p].y, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!pageSurface) {
+            std::cout << "Failed to create atlas page. Error: " << SDL_GetError() << std::endl;
+            pages.push_back(nullptr);
+            ok = false;
+            continue;
+        }
+        for (Image& img : images) {
+            if (img.page != static_cast<int>(p)) continue;
+            SDL_SetSurfaceBlendMode(img.surface, SDL_BLENDMODE_NONE); // Copy nguyên alpha
+            SDL_Rect dst = img.rect;
+            SDL_BlitSurface(img.surface, NULL, pageSurface, &dst);
+        }
+        SDL_Texture* page = SDL_CreateTextureFromSurface(renderer, pageSurface);
+        SDL_FreeSurface(pageSurface);
+        if (!page) {
+            std::cout << "Failed to upload atlas page. Error: " << SDL_GetError() << std::endl;
+            ok = false;
+        } else {
+            SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+        }
+        pages.push_back(page);
+    }
+
+    for (Image& img : images) {
+        SDL_FreeSurface(img.surface);
+        img.surface = nullptr;
+    }
+    std::cout << "Atlas: " << order.size() << " images packed into " << pages.size() << " page(s)." << std::endl;
+    return ok && !missing;
+}
+
+bool TextureAtlas::reload(int handle, SDL_Surface* surface) {
+    if (!surface) return false;
+    if (!built || handle < 0 || handle >= static_cast<int>(images.size())) { SDL_FreeSurface(surface); return false; }
+    const Image& img = images[handle];
+    SDL_Texture* page = img.page >= 0 ? pages[img.page] : nullptr;
+    bool ok = false;
+    if (img.alias >= 0 || !page) {
+        std::cout << "Cannot reload " << img.path << ": it has no cell of its own." << std::endl;
+    } else if (surface->w != img.rect.w || surface->h != img.rect.h) {
+        std::cout << "Cannot reload " << img.path << ": size changed, restart to repack the atlas." << std::endl;
+    } else {
+        // Upload theo đúng định dạng renderer đã chọn cho trang
+        Uint32 format;
+        SDL_QueryTexture(page, &format, NULL, NULL, NULL);
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+        ok = converted && SDL_UpdateTexture(page, &img.rect, converted->pixels, converted->pitch) == 0;
+        if (!ok) std::cout << "Failed to reload " << img.path << ". Error: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(converted);
+    }
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+int TextureAtlas::imageCount() const {
+    return static_cast<int>(std::count_if(images.begin(), images.end(), [](const Image& img) { return img.alias < 0; }));
+}
+
+SpriteRegion TextureAtlas::region(int handle) const {
+    SpriteRegion r;
+    if (!built || handle < 0 || handle >= static_cast<int>(images.size())) return r;
+    const Image* img = &images[handle];
+    if (img->alias >= 0) img = &images[img->alias];
+    if (img->page < 0) return r; // Load lỗi
+    r.texture = pages[img->page];
+    r.rect = img->rect;
+    return r;
+}
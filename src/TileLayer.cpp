@@ -0,0 +1,117 @@
+#include "TileLayer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    // Ô của từng TileType trên Tileset.png (lưới 32 px, 12 cột), -1 = không vẽ.
+    // Tileset không có hình nước: mặt nước được tô bằng WATER_COLOR.
+    int tilesetFrame(int tileType) {
+        switch (tileType) {
+            case TILE_GRASS: return 1;          // Cỏ phủ trên đá
+            case TILE_UNKNOWN_SOLID: return 13; // Đá đặc
+            default: return -1;
+        }
+    }
+    const SDL_Color WATER_COLOR = { 32, 72, 168, 255 };
+}
+
+TileLayer::TileLayer(SDL_Renderer* p_renderer, SDL_Texture* p_tileset, const TileMap& p_map)
+    : renderer(p_renderer), tileset(p_tileset), map(p_map),
+      tileWidth(p_map.getTileWidth()), tileHeight(p_map.getTileHeight()), chunksPerRow(0), bakes(0)
+{
+    // Phép tính chỉ số -> toạ độ của entity::setTileFrame, làm một lần cho cả bảng
+    int tilesetColumns = 1;
+    if (tileset) {
+        int w = 0, h = 0;
+        SDL_QueryTexture(tileset, NULL, NULL, &w, &h);
+        tilesetColumns = std::max(1, w / TILESET_TILE_SIZE);
+    }
+    for (int type = 0; type < 256; ++type) {
+        int frame = tilesetFrame(type);
+        sourceRect[type] = frame < 0 ? SDL_Rect{ 0, 0, 0, 0 }
+                                     : SDL_Rect{ (frame % tilesetColumns) * TILESET_TILE_SIZE, (frame / tilesetColumns) * TILESET_TILE_SIZE,
+                                                 TILESET_TILE_SIZE, TILESET_TILE_SIZE };
+    }
+
+    if (tileWidth <= 0 || tileHeight <= 0) return;
+    chunksPerRow = (map.getCols() + CHUNK_COLS - 1) / CHUNK_COLS;
+    for (int row0 = 0; row0 < map.getRows(); row0 += CHUNK_ROWS) {
+        for (int col0 = 0; col0 < map.getCols(); col0 += CHUNK_COLS) {
+            chunks.push_back(Chunk{ nullptr, col0, row0,
+                                    std::min(CHUNK_COLS, map.getCols() - col0), std::min(CHUNK_ROWS, map.getRows() - row0), true });
+        }
+    }
+}
+
+TileLayer::~TileLayer() {
+    for (Chunk& chunk : chunks) SDL_DestroyTexture(chunk.texture);
+}
+
+void TileLayer::markDirty(int col, int row) {
+    if (col < 0 || row < 0 || col >= map.getCols() || row >= map.getRows()) return;
+    chunks[(row / CHUNK_ROWS) * chunksPerRow + col / CHUNK_COLS].dirty = true;
+}
+
+void TileLayer::markAllDirty() {
+    for (Chunk& chunk : chunks) chunk.dirty = true;
+}
+
+bool TileLayer::bake(Chunk& chunk) {
+    if (!chunk.texture) {
+        chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                          chunk.cols * tileWidth, chunk.rows * tileHeight);
+        if (!chunk.texture) {
+            std::cout << "Failed to create tile chunk. Error: " << SDL_GetError() << std::endl;
+            chunk.dirty = false; // Không thử lại mỗi frame; markDirty()/markAllDirty() sẽ thử lại
+            return false;
+        }
+        SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_BlendMode blend;
+    float scaleX, scaleY; // Đổi target làm scale về 1, mà target trước đó có thể là render target độ phân giải thấp
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blend);
+    SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+
+    SDL_SetRenderTarget(renderer, chunk.texture);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); // Ô trống trong suốt để thấy màu nền phía sau
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, WATER_COLOR.r, WATER_COLOR.g, WATER_COLOR.b, WATER_COLOR.a);
+    for (int row = 0; row < chunk.rows; ++row) {
+        for (int col = 0; col < chunk.cols; ++col) {
+            int type = map.tileAt(chunk.col0 + col, chunk.row0 + row);
+            SDL_Rect dst = { col * tileWidth, row * tileHeight, tileWidth, tileHeight };
+            if (type == TILE_WATER_SURFACE) {
+                SDL_RenderFillRect(renderer, &dst);
+            } else if (sourceRect[type].w > 0) {
+                SDL_RenderCopy(renderer, tileset, &sourceRect[type], &dst);
+            }
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_RenderSetScale(renderer, scaleX, scaleY);
+    SDL_SetRenderDrawBlendMode(renderer, blend);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    chunk.dirty = false;
+    ++bakes;
+    return true;
+}
+
+void TileLayer::render(float cameraX, float cameraY, int screenWidth, int screenHeight) {
+    if (!tileset) return;
+    int camX = static_cast<int>(std::round(cameraX)), camY = static_cast<int>(std::round(cameraY));
+    for (Chunk& chunk : chunks) {
+        SDL_Rect dst = { chunk.col0 * tileWidth - camX, chunk.row0 * tileHeight - camY, chunk.cols * tileWidth, chunk.rows * tileHeight };
+        if (dst.x >= screenWidth || dst.x + dst.w <= 0 || dst.y >= screenHeight || dst.y + dst.h <= 0) continue;
+        if (chunk.dirty && !bake(chunk)) continue;
+        if (!chunk.texture) continue;
+        SDL_RenderCopy(renderer, chunk.texture, NULL, &dst);
+    }
+}
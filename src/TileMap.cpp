@@ -0,0 +1,98 @@
+#include "TileMap.hpp"
+#include <algorithm>
+#include <cmath>
+
+const std::uint8_t TileMap::FLAGS[256] = {
+    0,                              // TILE_EMPTY
+    TF_STANDABLE | TF_ONE_WAY,      // TILE_GRASS
+    TF_SOLID | TF_STANDABLE,        // TILE_UNKNOWN_SOLID
+    TF_WATER,                       // TILE_WATER_SURFACE
+    TF_TURRET_SPAWN,                // TILE_TURRET
+    TF_ABYSS                        // TILE_ABYSS
+};
+
+TileMap::TileMap(const std::vector<std::vector<int>>& p_rows, int p_tileWidth, int p_tileHeight)
+    : rows(static_cast<int>(p_rows.size())), cols(p_rows.empty() ? 0 : static_cast<int>(p_rows[0].size())),
+      tileWidth(std::max(1, p_tileWidth)), tileHeight(std::max(1, p_tileHeight)),
+      tiles(static_cast<std::size_t>(rows) * cols, TILE_EMPTY),
+      colRecip(((std::uint64_t(1) << 32) + tileWidth - 1) / tileWidth),
+      rowRecip(((std::uint64_t(1) << 32) + tileHeight - 1) / tileHeight),
+      wordsPerRow((cols + 63) / 64),
+      solidMask(static_cast<std::size_t>(rows) * wordsPerRow, 0),
+      standableMask(static_cast<std::size_t>(rows) * wordsPerRow, 0)
+{
+    for (int r = 0; r < rows; ++r) {
+        // Hàng ngắn hơn hàng đầu thì phần thiếu là TILE_EMPTY, giống getTileAt cũ
+        int rowCols = std::min(cols, static_cast<int>(p_rows[r].size()));
+        for (int c = 0; c < rowCols; ++c) {
+            int v = p_rows[r][c];
+            std::uint8_t tile = (v >= 0 && v < 256) ? static_cast<std::uint8_t>(v) : static_cast<std::uint8_t>(TILE_EMPTY);
+            tiles[static_cast<std::size_t>(r) * cols + c] = tile;
+
+            std::uint64_t bit = std::uint64_t(1) << (c & 63);
+            std::size_t word = static_cast<std::size_t>(r) * wordsPerRow + (c >> 6);
+            if (FLAGS[tile] & TF_SOLID) solidMask[word] |= bit;
+            if (FLAGS[tile] & TF_STANDABLE) standableMask[word] |= bit;
+        }
+    }
+}
+
+int TileMap::worldCol(float worldX) const { return static_cast<int>(std::floor(worldX / tileWidth)); }
+int TileMap::worldRow(float worldY) const { return static_cast<int>(std::floor(worldY / tileHeight)); }
+int TileMap::worldColCeil(float worldX) const { return static_cast<int>(std::ceil(worldX / tileWidth)); }
+
+bool TileMap::anyInMask(const std::vector<std::uint64_t>& mask, int col0, int row0, int col1, int row1) const {
+    col0 = std::max(col0, 0); row0 = std::max(row0, 0);
+    col1 = std::min(col1, cols - 1); row1 = std::min(row1, rows - 1);
+    if (col0 > col1 || row0 > row1) return false;
+
+    int w0 = col0 >> 6, w1 = col1 >> 6;
+    std::uint64_t firstMask = ~std::uint64_t(0) << (col0 & 63);
+    std::uint64_t lastMask = ~std::uint64_t(0) >> (63 - (col1 & 63));
+    for (int r = row0; r <= row1; ++r) {
+        const std::uint64_t* rowWords = &mask[static_cast<std::size_t>(r) * wordsPerRow];
+        for (int w = w0; w <= w1; ++w) {
+            std::uint64_t bits = rowWords[w];
+            if (w == w0) bits &= firstMask;
+            if (w == w1) bits &= lastMask;
+            if (bits) return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+int TileMap::standableRowCrossed(T x0, T x1, T fromY, T toY) const {
+    if (toY <= fromY) return -1;
+    int col0 = worldCol(x0), col1 = worldCol(x1);
+    int rowFirst = std::max(worldRow(fromY) + 1, 0); // Mặt trên r*tileHeight > fromY
+    int rowLast = std::min(worldRow(toY), rows - 1); // và <= toY
+    for (int r = rowFirst; r <= rowLast; ++r) {
+        if (anyStandable(col0, r, col1, r)) return r;
+    }
+    return -1;
+}
+
+template <typename T>
+int TileMap::solidColCrossed(T fromX, T toX, T y0, T y1) const {
+    int row0 = worldRow(y0), row1 = worldRow(y1);
+    if (toX > fromX) {
+        // Đi sang phải: cạnh trái c*tileWidth nằm trong (fromX, toX]
+        int colLast = std::min(worldCol(toX), cols - 1);
+        for (int c = std::max(worldCol(fromX) + 1, 0); c <= colLast; ++c) {
+            if (anySolid(c, row0, c, row1)) return c;
+        }
+    } else if (toX < fromX) {
+        // Đi sang trái: cạnh phải (c+1)*tileWidth nằm trong [toX, fromX)
+        int colFirst = std::max(worldColCeil(toX) - 1, 0);
+        for (int c = std::min(worldColCeil(fromX) - 2, cols - 1); c >= colFirst; --c) {
+            if (anySolid(c, row0, c, row1)) return c;
+        }
+    }
+    return -1;
+}
+
+int TileMap::firstStandableRowCrossed(float x0, float x1, float fromY, float toY) const { return standableRowCrossed(x0, x1, fromY, toY); }
+int TileMap::firstStandableRowCrossed(Fixed16 x0, Fixed16 x1, Fixed16 fromY, Fixed16 toY) const { return standableRowCrossed(x0, x1, fromY, toY); }
+int TileMap::firstSolidColCrossed(float fromX, float toX, float y0, float y1) const { return solidColCrossed(fromX, toX, y0, y1); }
+int TileMap::firstSolidColCrossed(Fixed16 fromX, Fixed16 toX, Fixed16 y0, Fixed16 y1) const { return solidColCrossed(fromX, toX, y0, y1); }
@@ -0,0 +1,236 @@
+#include "TurretPool.hpp"
+#include "sfx.hpp"
+#include <cmath>     
+#include <iostream>
+#include <algorithm> 
+#include <numeric>
+
+namespace
+{
+    // Sắp xếp lại một mảng SoA theo hoán vị order (order[k] = chỉ số cũ của phần tử thứ k)
+    template <typename T>
+    void applyOrder(std::vector<T>& v, const std::vector<std::size_t>& order) {
+        std::vector<T> sorted;
+        sorted.reserve(v.size());
+        for (std::size_t i : order) sorted.push_back(v[i]);
+        v.swap(sorted);
+    }
+}
+
+// --- Constructor ---
+TurretPool::TurretPool(const SpriteSheet& p_turretSheet, const SpriteSheet& p_explosionSheet, const SpriteRegion& p_bulletSprite,
+                       int p_tileWidth, int p_tileHeight)
+    : turretSheet(p_turretSheet), explosionSheet(p_explosionSheet), bulletSprite(p_bulletSprite),
+      renderWidthTurret(p_tileWidth), renderHeightTurret(p_tileHeight),
+      sheetFrameWidthExplosion(p_tileWidth), sheetFrameHeightExplosion(p_tileHeight),
+      detectionRadius(phys::real(DETECTION_RADIUS_TILES * p_tileWidth)), sortedByX(true)
+{
+    if (explosionSheet) {
+        sheetFrameWidthExplosion = explosionSheet.frameWidth;
+        sheetFrameHeightExplosion = explosionSheet.frameHeight;
+    }
+}
+
+std::size_t TurretPool::spawn(vector2d p_pos) {
+    if (!posX.empty() && phys::real(p_pos.x) < posX.back()) sortedByX = false;
+    posX.push_back(phys::real(p_pos.x)); posY.push_back(phys::real(p_pos.y));
+    shootTimer.push_back(phys::real(SHOOT_COOLDOWN));
+    animTimerTurret.push_back(phys::Real());
+    animTimerExplosion.push_back(phys::Real());
+    animFrameTurret.push_back(START_FRAME_TURRET_IDLE);
+    animFrameExplosion.push_back(0);
+    state.push_back(TurretState::IDLE);
+    hp.push_back(MAX_HP);
+    return posX.size() - 1;
+}
+
+void TurretPool::clear() {
+    posX.clear(); posY.clear(); shootTimer.clear(); animTimerTurret.clear(); animTimerExplosion.clear();
+    animFrameTurret.clear(); animFrameExplosion.clear(); state.clear(); hp.clear();
+    sortedByX = true;
+}
+
+void TurretPool::reserve(std::size_t n) {
+    posX.reserve(n); posY.reserve(n); shootTimer.reserve(n); animTimerTurret.reserve(n); animTimerExplosion.reserve(n);
+    animFrameTurret.reserve(n); animFrameExplosion.reserve(n); state.reserve(n); hp.reserve(n);
+}
+
+void TurretPool::sortByX() {
+    if (sortedByX) return;
+    std::vector<std::size_t> order(size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return posX[a] < posX[b]; });
+    applyOrder(posX, order); applyOrder(posY, order); applyOrder(shootTimer, order);
+    applyOrder(animTimerTurret, order); applyOrder(animTimerExplosion, order);
+    applyOrder(animFrameTurret, order); applyOrder(animFrameExplosion, order);
+    applyOrder(state, order); applyOrder(hp, order);
+    sortedByX = true;
+}
+
+void TurretPool::activeRange(float minX, float maxX, std::size_t& first, std::size_t& last) const {
+    if (!sortedByX) { first = 0; last = size(); return; }
+    // So sánh bằng float: biên vùng hoạt động có thể nằm ngoài khoảng biểu diễn của phys::Real
+    auto startsBefore = [](phys::Real x, float v) { return phys::toFloat(x) < v; };
+    auto startsAfter = [](float v, phys::Real x) { return v < phys::toFloat(x); };
+    first = static_cast<std::size_t>(std::lower_bound(posX.begin(), posX.end(), minX - renderWidthTurret, startsBefore) - posX.begin());
+    last = static_cast<std::size_t>(std::upper_bound(posX.begin() + first, posX.end(), maxX, startsAfter) - posX.begin());
+}
+
+// --- Update Method ---
+void TurretPool::update(float p_dt, Player* player, BulletPool& enemyBullets, float activeMinX, float activeMaxX) {
+    sortByX();
+    std::size_t first, last;
+    activeRange(activeMinX, activeMaxX, first, last);
+
+    const phys::Real dt = phys::real(p_dt);
+    // Tâm player không đổi trong lượt update này: tính một lần cho mọi turret
+    bool playerTargetable = player && !player->getIsDead() && !player->isInvulnerable();
+    phys::Real playerCenterX = phys::Real(), playerCenterY = phys::Real();
+    if (player) {
+        SDL_Rect playerHb = player->getWorldHitbox();
+        playerCenterX = phys::real(playerHb.x + playerHb.w / 2.0f);
+        playerCenterY = phys::real(playerHb.y + playerHb.h / 2.0f);
+    }
+    const phys::Real halfW = phys::real(renderWidthTurret / 2.0f), halfH = phys::real(renderHeightTurret / 2.0f);
+    const phys::Real animSpeedExplosion = phys::real(ANIM_SPEED_EXPLOSION);
+    const phys::Real animSpeedShoot = phys::real(ANIM_SPEED_TURRET_SHOOT), animSpeedIdle = phys::real(ANIM_SPEED_TURRET_IDLE);
+    std::uint16_t bulletTexId = enemyBullets.spriteId(bulletSprite);
+
+    for (std::size_t i = first; i < last; ++i) {
+        TurretState st = state[i];
+        if (st == TurretState::FULLY_DESTROYED) continue;
+
+        if (st == TurretState::DESTROYED_ANIM) {
+            animTimerExplosion[i] += dt;
+            if (animTimerExplosion[i] >= animSpeedExplosion) {
+                animTimerExplosion[i] -= animSpeedExplosion;
+                animFrameExplosion[i]++;
+                if (animFrameExplosion[i] >= NUM_FRAMES_EXPLOSION) {
+                    state[i] = TurretState::FULLY_DESTROYED;
+                    animFrameExplosion[i] = NUM_FRAMES_EXPLOSION - 1; // Giữ ở frame cuối
+                }
+            }
+            continue;
+        }
+
+        shootTimer[i] -= dt;
+        bool playerInRangeAndVisible = false;
+        if (playerTargetable) {
+            phys::Real dx = playerCenterX - (posX[i] + halfW);
+            phys::Real dy = playerCenterY - (posY[i] + halfH);
+            playerInRangeAndVisible = phys::withinRadius(dx, dy, detectionRadius);
+        }
+
+        if (st == TurretState::SHOOTING) {
+            animTimerTurret[i] += dt;
+            if (animTimerTurret[i] >= animSpeedShoot) {
+                animTimerTurret[i] -= animSpeedShoot;
+                animFrameTurret[i]++;
+                // Animation bắn đã chạy hết: quay lại frame idle đầu tiên
+                if (animFrameTurret[i] >= START_FRAME_TURRET_SHOOT + NUM_FRAMES_TURRET_SHOOT) {
+                    animFrameTurret[i] = START_FRAME_TURRET_IDLE;
+                    state[i] = TurretState::IDLE;
+                }
+            }
+        } else { // IDLE state
+            if (NUM_FRAMES_TURRET_IDLE > 1) { // Chỉ animate idle nếu có nhiều hơn 1 frame
+                animTimerTurret[i] += dt;
+                if (animTimerTurret[i] >= animSpeedIdle) {
+                    animTimerTurret[i] -= animSpeedIdle;
+                    int relativeFrame = (animFrameTurret[i] - START_FRAME_TURRET_IDLE + 1) % NUM_FRAMES_TURRET_IDLE;
+                    animFrameTurret[i] = static_cast<std::uint8_t>(START_FRAME_TURRET_IDLE + relativeFrame);
+                }
+            } else { // Nếu idle chỉ có 1 frame
+                animFrameTurret[i] = START_FRAME_TURRET_IDLE;
+            }
+
+            if (playerInRangeAndVisible && shootTimer[i] <= phys::Real()) {
+                shootAtPlayer(i, playerCenterX, playerCenterY, enemyBullets, bulletTexId);
+                shootTimer[i] = phys::real(SHOOT_COOLDOWN); // Reset cooldown
+                if (NUM_FRAMES_TURRET_SHOOT > 0) { // Chỉ chuyển sang SHOOTING nếu có animation bắn
+                    state[i] = TurretState::SHOOTING;
+                    animFrameTurret[i] = START_FRAME_TURRET_SHOOT;
+                    animTimerTurret[i] = phys::Real();
+                }
+            }
+        }
+    }
+}
+
+// --- ShootAtPlayer Method ---
+void TurretPool::shootAtPlayer(std::size_t i, phys::Real playerCenterX, phys::Real playerCenterY, BulletPool& enemyBullets, std::uint16_t bulletTexId) {
+    phys::Real turretCenterX = posX[i] + phys::real(renderWidthTurret / 2.0f);
+    phys::Real turretCenterY = posY[i] + phys::real(renderHeightTurret / 2.0f);
+
+    // Tính toán vị trí góc trên trái của viên đạn để tâm của nó ở turretCenter
+    phys::Vec2 bulletTopLeftSpawnPos = {
+        turretCenterX - phys::real(static_cast<float>(TURRET_BULLET_RENDER_W) / 2.0f),
+        turretCenterY - phys::real(static_cast<float>(TURRET_BULLET_RENDER_H) / 2.0f)
+    };
+
+    phys::Real dx = playerCenterX - turretCenterX;
+    phys::Real dy = playerCenterY - turretCenterY;
+    phys::Real bulletVelX = phys::Real(), bulletVelY = phys::Real();
+    const phys::Real epsilon = phys::real(0.1f);
+    const phys::Real speed = phys::real(TURRET_BULLET_SPEED), diagonalSpeed = phys::real(TURRET_DIAGONAL_SPEED_COMPONENT);
+
+    if (phys::abs(dx) < epsilon && phys::abs(dy) < epsilon) {
+        bulletVelX = speed;
+    } else {
+        phys::Real absDx = phys::abs(dx);
+        phys::Real absDy = phys::abs(dy);
+        const phys::Real diagonalThresholdRatio = phys::real(0.414f);
+
+        if (absDy < absDx * diagonalThresholdRatio) {
+            bulletVelX = phys::copysign(speed, dx);
+        } else {
+            bulletVelX = phys::copysign(diagonalSpeed, dx);
+            bulletVelY = phys::copysign(diagonalSpeed, dy);
+        }
+    }
+
+    // Pool đầy thì bỏ phát bắn này (không cấp phát thêm trong tick)
+    phys::Vec2 bulletVel = { bulletVelX, bulletVelY };
+    if (enemyBullets.spawn(bulletTopLeftSpawnPos, bulletVel, TURRET_BULLET_RENDER_W, TURRET_BULLET_RENDER_H, bulletTexId)) {
+        sfx::play(SoundEffect::TURRET_SHOOT, phys::toFloat(turretCenterX));
+    }
+}
+
+// --- takeDamage Method ---
+void TurretPool::takeDamage(std::size_t i) {
+    if (state[i] == TurretState::DESTROYED_ANIM || state[i] == TurretState::FULLY_DESTROYED) return;
+    hp[i]--;
+    if (hp[i] <= 0) {
+        state[i] = TurretState::DESTROYED_ANIM;
+        animTimerExplosion[i] = phys::Real();
+        animFrameExplosion[i] = 0; 
+        sfx::play(SoundEffect::TURRET_EXPLOSION, phys::toFloat(posX[i]) + renderWidthTurret / 2.0f);
+    }
+}
+
+void TurretPool::removeDead() {
+    // Dồn các turret còn lại lên đầu theo đúng thứ tự cũ để pool vẫn xếp theo x
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+        if (state[i] == TurretState::FULLY_DESTROYED) continue;
+        if (kept != i) moveEntry(i, kept);
+        ++kept;
+    }
+    if (kept != size()) resize(kept);
+}
+
+void TurretPool::moveEntry(std::size_t from, std::size_t to) {
+    posX[to] = posX[from]; posY[to] = posY[from];
+    shootTimer[to] = shootTimer[from];
+    animTimerTurret[to] = animTimerTurret[from];
+    animTimerExplosion[to] = animTimerExplosion[from];
+    animFrameTurret[to] = animFrameTurret[from];
+    animFrameExplosion[to] = animFrameExplosion[from];
+    state[to] = state[from];
+    hp[to] = hp[from];
+}
+
+void TurretPool::resize(std::size_t n) {
+    posX.resize(n); posY.resize(n); shootTimer.resize(n); animTimerTurret.resize(n); animTimerExplosion.resize(n);
+    animFrameTurret.resize(n); animFrameExplosion.resize(n); state.resize(n); hp.resize(n);
+}
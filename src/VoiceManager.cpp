@@ -0,0 +1,100 @@
+#include "VoiceManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+VoiceManager::VoiceManager(int p_channelCount)
+    : cameraX(0.0f), viewWidth(0.0f), playCount(0)
+{
+    int allocated = Mix_AllocateChannels(std::max(1, p_channelCount));
+    voices.resize(static_cast<std::size_t>(std::max(1, allocated)));
+}
+
+VoiceManager::~VoiceManager() {
+    stopAll();
+}
+
+void VoiceManager::setRule(SoundEffect effect, const VoiceRule& rule) {
+    rules[static_cast<int>(effect)] = rule;
+}
+
+void VoiceManager::stopAll() {
+    Mix_HaltChannel(-1);
+    for (Voice& voice : voices) voice = Voice();
+}
+
+int VoiceManager::activeCount() const {
+    int count = 0;
+    for (int channel = 0; channel < channelCount(); ++channel) if (isActive(channel)) ++count;
+    return count;
+}
+
+bool VoiceManager::play(SoundEffect effect, Mix_Chunk* chunk, float x, std::uint64_t tick) {
+    if (!chunk) return false;
+    const int id = static_cast<int>(effect);
+    const VoiceRule& rule = rules[id];
+
+    // Khoảng cách tính từ giữa khung nhìn; trong khung nhìn thì nghe đủ, ra ngoài thì nhỏ dần
+    float gain = 1.0f, pan = 0.0f;
+    if (!std::isnan(x) && viewWidth > 0.0f) {
+        const float halfView = viewWidth / 2.0f;
+        const float dx = x - (cameraX + halfView);
+        pan = std::max(-1.0f, std::min(dx / halfView, 1.0f)) * PAN_RANGE;
+        const float outside = std::fabs(dx) - halfView;
+        if (rule.attenuate && outside > 0.0f) gain = 1.0f - outside / CULL_DISTANCE;
+    }
+    if (gain <= 0.0f) return false;
+
+    // Cùng hiệu ứng trong cùng tick: giữ một kênh, lấy nguồn gần hơn
+    for (int channel = 0; channel < channelCount(); ++channel) {
+        Voice& voice = voices[channel];
+        if (voice.effect != id || voice.tick != tick || !isActive(channel)) continue;
+        if (gain > voice.gain) {
+            voice.gain = gain;
+            applyMix(channel, rule.volume * gain, pan);
+        }
+        return true;
+    }
+
+    const int channel = pickChannel(id, rule.priority, gain);
+    if (channel < 0) return false;
+    applyMix(channel, rule.volume * gain, pan);
+    if (Mix_PlayChannel(channel, chunk, 0) < 0) { // Kênh đang phát thì SDL_mixer dừng nó trước
+        voices[channel] = Voice();
+        return false;
+    }
+    voices[channel] = Voice{ id, rule.priority, gain, ++playCount, tick };
+    return true;
+}
+
+int VoiceManager::pickChannel(int effect, int priority, float gain) const {
+    // Đủ số kênh cho hiệu ứng này rồi: thay kênh cũ nhất của chính nó
+    int sameCount = 0, oldestSame = -1;
+    for (int channel = 0; channel < channelCount(); ++channel) {
+        if (voices[channel].effect != effect || !isActive(channel)) continue;
+        ++sameCount;
+        if (oldestSame < 0 || voices[channel].started < voices[oldestSame].started) oldestSame = channel;
+    }
+    if (sameCount >= std::max(1, rules[effect].maxVoices)) return oldestSame;
+
+    for (int channel = 0; channel < channelCount(); ++channel)
+        if (!isActive(channel)) return channel;
+
+    // Hết kênh: ưu tiên thấp nhất, rồi nhỏ tiếng nhất, rồi cũ nhất
+    int victim = 0;
+    for (int channel = 1; channel < channelCount(); ++channel) {
+        const Voice& a = voices[channel];
+        const Voice& b = voices[victim];
+        if (a.priority != b.priority ? a.priority < b.priority : a.gain != b.gain ? a.gain < b.gain : a.started < b.started) victim = channel;
+    }
+    const Voice& candidate = voices[victim];
+    if (candidate.priority > priority || (candidate.priority == priority && candidate.gain > gain)) return -1;
+    return victim;
+}
+
+void VoiceManager::applyMix(int channel, float volume, float pan) const {
+    Mix_Volume(channel, static_cast<int>(std::lround(MIX_MAX_VOLUME * std::max(0.0f, std::min(volume, 1.0f)))));
+    // Pan 0 cho (255, 255): SDL_mixer gỡ hẳn hiệu ứng panning của kênh
+    const Uint8 left = static_cast<Uint8>(std::lround(255.0f * std::min(1.0f, 1.0f - pan)));
+    const Uint8 right = static_cast<Uint8>(std::lround(255.0f * std::min(1.0f, 1.0f + pan)));
+    Mix_SetPanning(channel, left, right);
+}
@@ -0,0 +1,217 @@
+#include "World.hpp"
+#include "sfx.hpp"
+#include "Collision.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+World::World(const TileMap& p_map, const WorldTextures& p_textures)
+    : player(nullptr), playerBullets(PLAYER_BULLET_CAPACITY), enemyBullets(ENEMY_BULLET_CAPACITY),
+      enemies(p_textures.enemy),
+      turrets(p_textures.turret, p_textures.turretExplosion, p_textures.turretBullet, p_map.getTileWidth(), p_map.getTileHeight()),
+      score(0), cameraX(0.0f), cameraY(0.0f), prevCameraX(0.0f), prevCameraY(0.0f), winConditionX(0.0f), wonFlag(false), sweptCollision(true),
+      activityRegion(true), viewWidth(0),
+      map(p_map), tileWidth(p_map.getTileWidth()), tileHeight(p_map.getTileHeight()), textures(p_textures), playerBulletTexId(0),
+      enemyGrid(tileWidth), turretGrid(tileWidth)
+{
+    if (!isMapSupported()) {
+        std::cerr << "Error: map is " << map.getCols() * tileWidth << "x" << map.getRows() * tileHeight
+                  << " px, fixed-point physics only supports worlds under " << Fixed16::INT_LIMIT << " px" << std::endl;
+    }
+    int mapCols = map.getCols();
+    winConditionX = static_cast<float>((mapCols > 3 ? mapCols - 3 : (mapCols > 0 ? mapCols -1 : 0)) * tileWidth);
+
+    // Đăng ký sprite trước để Turret::shootAtPlayer không phải thêm vào bảng trong tick
+    playerBulletTexId = playerBullets.spriteId(textures.playerBullet);
+    enemyBullets.spriteId(textures.turretBullet);
+}
+
+void World::reset() {
+    playerBullets.clear(); enemyBullets.clear(); enemies.clear(); turrets.clear();
+    score = 0;
+    cameraX = 0.0f; cameraY = 0.0f;
+    prevCameraX = 0.0f; prevCameraY = 0.0f;
+    wonFlag = false;
+
+    auto spawnEnemy = [&](float wx, int gr){ float eh=72.f; float gy=static_cast<float>(gr*tileHeight); float sy=gy-eh; enemies.spawn(vector2d{wx, sy}); };
+    spawnEnemy(8.0f*tileWidth, 3); spawnEnemy(15.0f*tileWidth, 3); spawnEnemy(40.0f*tileWidth, 2);
+    // Duyệt theo cột để turret được spawn theo x tăng dần, TurretPool không phải sắp xếp lại
+    for (int c = 0; c < map.getCols(); ++c) {
+        for (int r = 0; r < map.getRows(); ++r) {
+            if (map.flagsAt(c, r) & TF_TURRET_SPAWN) {
+                float tx=static_cast<float>(c*tileWidth); float ty=static_cast<float>(r*tileHeight);
+                turrets.spawn(vector2d{tx, ty});
+            }
+        }
+    }
+}
+
+void World::activeBounds(float& minX, float& maxX) const {
+    if (!activityRegion || viewWidth <= 0) {
+        minX = std::numeric_limits<float>::lowest(); maxX = std::numeric_limits<float>::max();
+        return;
+    }
+    minX = cameraX - ACTIVITY_MARGIN;
+    maxX = cameraX + static_cast<float>(viewWidth) + ACTIVITY_MARGIN;
+}
+
+void World::step(float dt) {
+    // Player, lính và đạn tự ghi vị trí đầu tick trong update(); camera ghi ở đây
+    prevCameraX = cameraX; prevCameraY = cameraY;
+    if(player) { player->update(dt, map); player->clampLeft(phys::real(cameraX)); }
+    // Entity ngoài vùng hoạt động không được update và không vào lưới va chạm: chi phí mỗi tick
+    // theo số entity quanh camera chứ không theo tổng số entity của màn
+    float activeMinX, activeMaxX;
+    activeBounds(activeMinX, activeMaxX);
+    enemies.update(dt, map, activeMinX, activeMaxX);
+    turrets.update(dt, player, enemyBullets, activeMinX, activeMaxX);
+
+    // Player Bullets Collisions
+    // Mỗi viên chỉ kiểm tra lính/turret nằm chung ô lưới với đường bay trong tick. Lính được ưu tiên
+    // trước turret như vòng lặp cũ; trong cùng loại lấy mục tiêu chạm sớm nhất, hòa thì id nhỏ nhất.
+    buildTargetGrids(activeMinX, activeMaxX);
+    playerBullets.update(dt); // Viên hết hạn đã bị xóa trong update
+    for (std::size_t i = 0; i < playerBullets.size(); ) {
+        BulletSweep sweep = sweepOf(playerBullets, i, dt);
+        bool hit = false;
+
+        int enemyId = -1; phys::Real enemyT = phys::Real();
+        enemyGrid.queryHits(sweep.bounds, [&](int id) {
+            phys::Real t;
+            if (enemies.isAlive(id) && hitTime(sweep, enemyBoxes[id], t) &&
+                (enemyId < 0 || t < enemyT || (t == enemyT && id < enemyId))) { enemyId = id; enemyT = t; }
+        });
+        if (enemyId >= 0) {
+            bool wasA = enemies.isAlive(enemyId);
+            enemies.takeHit(enemyId);
+            if(wasA && !enemies.isAlive(enemyId)) score+=200;
+            hit = true;
+        }
+        if (!hit) {
+            int turretId = -1; phys::Real turretT = phys::Real();
+            turretGrid.queryHits(sweep.bounds, [&](int id) {
+                phys::Real t;
+                if (turrets.getHp(id) > 0 && hitTime(sweep, turretBoxes[id], t) &&
+                    (turretId < 0 || t < turretT || (t == turretT && id < turretId))) { turretId = id; turretT = t; }
+            });
+            if (turretId >= 0) { // Chỉ va chạm với Turret còn sống
+                int hpB=turrets.getHp(turretId);
+                turrets.takeDamage(turretId);
+                if(hpB>0 && turrets.getHp(turretId)<=0) score+=500;
+                hit = true;
+            }
+        }
+
+        if (hit) playerBullets.remove(i); // Swap-and-pop: không tăng i
+        else ++i;
+    }
+
+    // Enemy Bullets Collisions
+    // Hộp bao đường bay của mọi viên được kiểm tra với hitbox player theo lô; chỉ viên lọt qua
+    // mới kiểm tra chính xác. Player trúng đạn thì chết hoặc bất tử nên thường dừng sau lần đầu.
+    enemyBullets.update(dt);
+    while (player && !player->getIsDead() && !player->isInvulnerable() && !enemyBullets.empty()) {
+        SDL_Rect pHB = player->getWorldHitbox();
+        enemyBullets.gatherBounds(sweptCollision ? dt : 0.0f, enemyBulletBounds);
+        hitMask.resize((enemyBullets.size() + 31) / 32);
+        if (enemyBulletBounds.intersect(aabb::fromRect(pHB), 0, enemyBullets.size(), hitMask.data()) == 0) break;
+
+        std::size_t hitIndex = enemyBullets.size();
+        for (std::size_t w = 0; w < hitMask.size() && hitIndex == enemyBullets.size(); ++w) {
+            for (std::uint32_t bits = hitMask[w]; bits; bits &= bits - 1) {
+                std::size_t i = w * 32 + aabb::lowestBit(bits);
+                phys::Real t;
+                if (hitTime(sweepOf(enemyBullets, i, dt), pHB, t)) { hitIndex = i; break; }
+            }
+        }
+        if (hitIndex == enemyBullets.size()) break;
+
+        player->takeHit(false); // Âm thanh chết do Player::takeHit phát
+        enemyBullets.remove(hitIndex);
+    }
+}
+
+World::BulletSweep World::sweepOf(const BulletPool& pool, std::size_t i, float p_dt) const {
+    const phys::Real dt = phys::real(p_dt);
+    BulletSweep sweep;
+    sweep.end = pool.getWorldHitbox(i);
+    sweep.w = phys::Real(pool.renderWidth(i));
+    sweep.h = phys::Real(pool.renderHeight(i));
+    if (sweptCollision) {
+        // Vị trí đầu tick suy ra từ vận tốc (đạn bay thẳng đều), cùng phép nhân với BulletPool::update
+        sweep.dx = pool.velocityX(i) * dt; sweep.dy = pool.velocityY(i) * dt;
+        sweep.x0 = pool.x(i) - sweep.dx; sweep.y0 = pool.y(i) - sweep.dy;
+        sweep.bounds = collision::unionRect(sweep.end, collision::sweptBounds(sweep.x0, sweep.y0, sweep.w, sweep.h, sweep.dx, sweep.dy));
+    } else {
+        sweep.dx = sweep.dy = phys::Real();
+        sweep.x0 = pool.x(i); sweep.y0 = pool.y(i);
+        sweep.bounds = sweep.end;
+    }
+    return sweep;
+}
+
+bool World::hitTime(const BulletSweep& sweep, const SDL_Rect& target, phys::Real& outT) const {
+    // Giao nhau tại vị trí cuối tick luôn tính là trúng (đường cũ, và là fallback khi tắt sweptCollision)
+    if (sweptCollision && collision::sweptAABB(sweep.x0, sweep.y0, sweep.w, sweep.h, sweep.dx, sweep.dy, target, outT)) return true;
+    if (SDL_HasIntersection(&sweep.end, &target)) { outT = phys::Real(1); return true; }
+    return false;
+}
+
+void World::buildTargetGrids(float activeMinX, float activeMaxX) {
+    // enemyBoxes/turretBoxes được tra theo chỉ số; chỉ mục tiêu còn sống trong vùng hoạt động có hộp và vào lưới
+    enemyGrid.clear(); enemyBoxes.resize(enemies.size());
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        if (!enemies.isAlive(i) || !enemies.isActive(i, activeMinX, activeMaxX)) continue;
+        enemyBoxes[i] = enemies.getWorldHitbox(i);
+        enemyGrid.insert(static_cast<int>(i), enemyBoxes[i]);
+    }
+    enemyGrid.build();
+
+    // Turret xếp theo x: chỉ duyệt đoạn nằm trong vùng hoạt động
+    std::size_t first, last;
+    turrets.activeRange(activeMinX, activeMaxX, first, last);
+    turretGrid.clear(); turretBoxes.resize(turrets.size());
+    for (std::size_t i = first; i < last; ++i) {
+        if (turrets.getHp(i) <= 0) continue;
+        turretBoxes[i] = turrets.getWorldHitbox(i);
+        turretGrid.insert(static_cast<int>(i), turretBoxes[i]);
+    }
+    turretGrid.build();
+}
+
+void World::removeDead() {
+    enemies.removeDead();
+    turrets.removeDead();
+}
+
+WorldEvent World::checkProgress() {
+    if (!player) return WorldEvent::NONE;
+    if (player->getCurrentState() == PlayerState::DEAD) {
+        if (player->getLives() > 0) {
+            player->respawn(cameraX, PLAYER_START_Y, PLAYER_RESPAWN_OFFSET_X);
+            return WorldEvent::NONE;
+        }
+        return WorldEvent::PLAYER_OUT_OF_LIVES;
+    }
+    if (!player->getIsDead() && player->getPos().x + PLAYER_STANDARD_FRAME_W/2.0f >= winConditionX && !wonFlag) {
+        wonFlag = true;
+        return WorldEvent::PLAYER_REACHED_GOAL;
+    }
+    return WorldEvent::NONE;
+}
+
+void World::firePlayerBullets() {
+    if (!player) return;
+    phys::Vec2 bs, bv;
+    if (player->wantsToShoot(bs, bv)) {
+        if (playerBullets.spawn(bs, bv, PLAYER_BULLET_RENDER_WIDTH, PLAYER_BULLET_RENDER_HEIGHT, playerBulletTexId)) {
+            sfx::play(SoundEffect::PLAYER_SHOOT, phys::toFloat(bs.x));
+        }
+    }
+}
+
+void World::followCamera(int screenWidth) {
+    viewWidth = screenWidth;
+    // Tính theo kiểu vật lý: cameraX chặn vị trí player ở tick sau nên cũng phải tất định
+    if(player && !player->getIsDead()){ SDL_Rect pHB = player->getWorldHitbox(); phys::Real pCX = phys::real(pHB.x + pHB.w / 2.0f); float tCX = phys::toFloat(pCX - phys::Real(screenWidth) / phys::real(2.5f)); if (tCX > cameraX) { cameraX = tCX; } }
+}
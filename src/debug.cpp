@@ -3,6 +3,8 @@
 #include <SDL2/SDL_ttf.h>
 #include <vector>
 #include <cmath>
+#include <string>
+#include <algorithm>
 
 void Debug::drawGrid(SDL_Renderer* renderer, float cameraX, float cameraY, 
                     const std::vector<std::vector<int>>& mapData, 
@@ -20,7 +22,7 @@ void Debug::drawGrid(SDL_Renderer* renderer, float cameraX, float cameraY,
         SDL_RenderDrawLine(renderer, sx, 0, sx, screenHeight);
     }
     
-    for(int r = 0; r < mapData.size()+1; ++r) {
+    for(int r = 0; r < static_cast<int>(mapData.size())+1; ++r) {
         int sy = static_cast<int>(round(r*tileHeight-cameraY));
         SDL_RenderDrawLine(renderer, 0, sy, screenWidth, sy);
     }
@@ -29,28 +31,28 @@ void Debug::drawGrid(SDL_Renderer* renderer, float cameraX, float cameraY,
 void Debug::drawTileNumbers(SDL_Renderer* renderer, TTF_Font* font, 
                           float cameraX, float cameraY,
                           const std::vector<std::vector<int>>& mapData,
-                          int tileWidth, int tileHeight) {
+                          int tileWidth, int tileHeight, int screenWidth, int screenHeight) {
     if (!renderer || !font) return;
     
     SDL_Color textColor = {255, 255, 0, 255};
     int startCol = static_cast<int>(floor(cameraX / tileWidth));
-    int endCol = startCol + static_cast<int>(ceil(static_cast<float>(SCREEN_WIDTH) / tileWidth)) + 1;
+    int endCol = startCol + static_cast<int>(ceil(static_cast<float>(screenWidth) / tileWidth)) + 1;
     endCol = std::min(endCol, static_cast<int>(mapData[0].size()));
 
-    for (int r = 0; r < mapData.size(); ++r) {
+    for (int r = 0; r < static_cast<int>(mapData.size()); ++r) {
         for (int c = startCol; c < endCol; ++c) {
-            if (c < 0 || c >= mapData[0].size()) continue;
-            if (r < 0 || r >= mapData.size()) continue;
+            if (c < 0 || c >= static_cast<int>(mapData[0].size())) continue;
+            if (r < 0 || r >= static_cast<int>(mapData.size())) continue;
 
             int screenX = static_cast<int>(round(c * tileWidth - cameraX));
             int screenY = static_cast<int>(round(r * tileHeight - cameraY));
 
-            if (screenX + tileWidth < 0 || screenX > SCREEN_WIDTH ||
-                screenY + tileHeight < 0 || screenY > SCREEN_HEIGHT) {
+            if (screenX + tileWidth < 0 || screenX > screenWidth ||
+                screenY + tileHeight < 0 || screenY > screenHeight) {
                 continue;
             }
             
-            string tileText = std::to_string(mapData[r][c]);
+            std::string tileText = std::to_string(mapData[r][c]);
             SDL_Surface* surface = TTF_RenderText_Solid(font, tileText.c_str(), textColor);
             if (surface) {
                 SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
@@ -0,0 +1,100 @@
+#include "Headless.hpp"
+#include "World.hpp"
+#include "map.hpp"
+#include "utils.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// FNV-1a trên từng byte của giá trị (float lấy nguyên bit pattern)
+struct StateHasher {
+    std::uint64_t h = 1469598103934665603ull;
+    template <typename T> void add(const T& v) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        for (unsigned char b : bytes) { h ^= b; h *= 1099511628211ull; }
+    }
+};
+
+std::uint64_t hashWorld(World& world, const Player& player) {
+    StateHasher hasher;
+    hasher.add(world.score);
+    hasher.add(player.getPos().x); hasher.add(player.getPos().y);
+    for (std::size_t i = 0; i < world.enemies.size(); ++i) { hasher.add(world.enemies.getPos(i).x); hasher.add(world.enemies.getPos(i).y); }
+    for (std::size_t i = 0; i < world.turrets.size(); ++i) hasher.add(world.turrets.getHp(i));
+    for (std::size_t i = 0; i < world.playerBullets.size(); ++i) { hasher.add(phys::toFloat(world.playerBullets.x(i))); hasher.add(phys::toFloat(world.playerBullets.y(i))); }
+    for (std::size_t i = 0; i < world.enemyBullets.size(); ++i) { hasher.add(phys::toFloat(world.enemyBullets.x(i))); hasher.add(phys::toFloat(world.enemyBullets.y(i))); }
+    return hasher.h;
+}
+
+} // namespace
+
+HeadlessStats runHeadless(const HeadlessOptions& options) {
+    HeadlessStats stats;
+    TileMap stageMap(mapData, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT);
+    World world(stageMap, WorldTextures{});
+    if (!world.isMapSupported()) return stats; // World đã in lỗi, không chạy tick nào
+    Player player(vector2d{World::PLAYER_START_X, World::PLAYER_START_Y},
+                  World::PLAYER_STANDARD_FRAME_W, World::PLAYER_STANDARD_FRAME_H,
+                  World::PLAYER_LYING_FRAME_W, World::PLAYER_LYING_FRAME_H);
+    world.player = &player;
+    world.sweptCollision = options.sweptCollision;
+    world.activityRegion = options.activityRegion;
+    world.reset();
+
+    // Bàn phím giả lập, cùng layout với mảng của SDL_GetKeyboardState
+    Uint8 keyStates[SDL_NUM_SCANCODES] = {};
+    if (options.autoPlay) {
+        keyStates[SDL_SCANCODE_RIGHT] = 1;
+        keyStates[SDL_SCANCODE_F] = 1;
+    }
+
+    const float maxCameraX = std::max(0.0f, stageMap.getWorldWidth() - options.screenWidth);
+
+    std::streambuf* coutBuf = std::cout.rdbuf();
+    if (options.quiet) std::cout.rdbuf(nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < options.ticks; ++i) {
+        player.handleInput(keyStates);
+        world.step(options.timeStep);
+        world.removeDead();
+
+        if (world.checkProgress() != WorldEvent::NONE) {
+            // Thắng hoặc hết mạng: chơi lại từ đầu để luôn đủ tải cho N tick
+            stats.lastScore = world.score;
+            stats.restarts++;
+            player.resetPlayerStateForNewGame();
+            player.setPos(vector2d{World::PLAYER_START_X, World::PLAYER_START_Y});
+            world.reset();
+        }
+        world.firePlayerBullets();
+        world.followCamera(options.screenWidth);
+        world.cameraX = utils::clamp(world.cameraX, 0.0f, maxCameraX);
+
+        stats.maxPlayerBullets = std::max(stats.maxPlayerBullets, static_cast<long>(world.playerBullets.size()));
+        stats.maxEnemyBullets = std::max(stats.maxEnemyBullets, static_cast<long>(world.enemyBullets.size()));
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout.rdbuf(coutBuf);
+    std::cout.clear(); // rdbuf(nullptr) bật badbit
+
+    stats.ticks = options.ticks;
+    stats.simSeconds = options.ticks * static_cast<double>(options.timeStep);
+    stats.seconds = std::chrono::duration<double>(end - start).count();
+    if (stats.restarts == 0) stats.lastScore = world.score;
+    stats.stateHash = hashWorld(world, player);
+    return stats;
+}
+
+void printHeadlessStats(const HeadlessStats& stats) {
+    std::cout << "Headless: " << stats.ticks << " ticks (" << stats.simSeconds << " s simulated) in " << stats.seconds << " s" << std::endl;
+    std::cout << "  ticks/s: " << stats.ticksPerSecond() << ", ns/tick: " << stats.nsPerTick() << std::endl;
+    std::cout << "  restarts: " << stats.restarts << ", last score: " << stats.lastScore
+              << ", max bullets (player/enemy): " << stats.maxPlayerBullets << "/" << stats.maxEnemyBullets << std::endl;
+    std::cout << "  state hash: " << std::hex << stats.stateHash << std::dec << std::endl;
+}
@@ -6,18 +6,32 @@
 #include <vector>
 #include <cmath>
 #include <algorithm> // For std::max, std::min, std::remove_if
-#include <list>
 #include <string>    // For std::to_string
-#include <memory>    // Có thể dùng sau này
 
 // Bao gồm các header của dự án
 #include "RenderWindow.hpp" 
 #include "math.hpp"
 #include "utils.hpp"
 #include "player.hpp"
-#include "Bullet.hpp"
-#include "Enemy.hpp"
-#include "Turret.hpp"
+#include "BulletPool.hpp"
+#include "EnemyPool.hpp"
+#include "TurretPool.hpp"
+#include "World.hpp"
+#include "map.hpp"
+#include "sfx.hpp"
+#include "Headless.hpp"
+#include "ChunkedBackground.hpp"
+#include "TextRenderer.hpp"
+#include "TileLayer.hpp"
+#include "FrameLimiter.hpp"
+#include "ResolutionScaler.hpp"
+#include "HudLayer.hpp"
+#include "SimThread.hpp"
+#include "AssetManager.hpp"
+#include "AssetArchive.hpp"
+#include "Qoi.hpp"
+#include "VoiceManager.hpp"
+#include <cstdio>
 
 using namespace std;
 
@@ -30,306 +44,313 @@ using namespace std;
 // --- Game State Enum ---
 enum class GameState { MAIN_MENU, PLAYING, WON, GAME_OVER };
 
-// --- Tile Logic Config ---
-const int LOGICAL_TILE_WIDTH = 96;
-const int LOGICAL_TILE_HEIGHT = 96;
+// Tài nguyên của game và âm thanh ứng với từng SoundEffect (theo thứ tự enum)
+const int NUM_SOUND_EFFECTS = static_cast<int>(SoundEffect::TURRET_EXPLOSION) + 1;
+AssetManager* gAssets = nullptr;
+VoiceManager* gVoices = nullptr;
+SoundHandle gSoundEffects[NUM_SOUND_EFFECTS];
 
-// --- Map Data ---
-vector<vector<int>> mapData = {
-    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,4,1,1,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,0,0,0,4,0,1,1,0,0,4,0,0,1,1,0,0,1,1,4,0,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,0},
-    {0,0,0,0,1,1,1,0,0,0,0,0,1,1,0,0,0,4,0,1,1,1,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,4,4,4,1,1,0,1,1,1,1,1,1,1,0,0,0,0,4,0,0,0,0,1,0,1,1,1,0,0,1,1,0,0,0,0,1,0,0,1,1,1,1,1,0,0,0,0,0,1,1,0,0,0,0,1,0,0},
-    {0,0,0,0,0,0,0,1,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,1,1,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0,0,0,1,1,1,0,1,0},
-    {3,3,3,3,3,3,3,3,1,1,3,3,3,3,3,3,3,3,1,1,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,1,1,1,3,3,3,3,3,3,3,1,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,1,1,1,1,1,1,1}
-};
-
-// Global sound chunks
-Mix_Chunk* gEnemyDeathSound = nullptr;
-Mix_Chunk* gPlayerDeathSound = nullptr;
-Mix_Chunk* gTurretExplosionSound = nullptr;
-Mix_Chunk* gTurretShootSound = nullptr;
+// Phát SimEvent::SOUND: logic game trong contra_core chỉ báo hiệu ứng, ở đây mới gọi SDL_mixer qua VoiceManager
+void playSoundEffect(SoundEffect effect, float x, std::uint64_t tick) {
+    Mix_Chunk* chunk = gAssets ? gAssets->get(gSoundEffects[static_cast<int>(effect)]) : nullptr;
+    if (gVoices) gVoices->play(effect, chunk, x, tick);
+}
 
 
 // --- Hàm chính ---
 int main(int argc, char* args[]) { 
+    // --tick-rate HZ: nhịp fixed-step của mô phỏng (30/60/100, mặc định 100)
+    // --discrete: tắt va chạm quét, chỉ kiểm tra giao nhau cuối tick
+    // --tile-layer: vẽ màn chơi từ mapData + Tileset.png thay cho ảnh nền vẽ tay
+    // --full-sim: update mọi lính/turret của màn mỗi tick, kể cả ở xa camera
+    // --vsync: SDL_RenderPresent chờ vsync thay cho bộ giới hạn frame
+    // --render-res WxH: vẽ vào render target W×H (vd. 256x224, 512x336) rồi phóng lên cửa sổ
+    // --dynamic-res: tự hạ/nâng độ phân giải render để giữ thời gian render trong ngân sách
+    // --single-thread: chạy mô phỏng ngay trên main thread thay cho thread riêng
+    // --hot-reload: sửa ảnh/âm thanh trên đĩa thì load lại ngay trong lúc chơi
+    // --pack FILE: archive tài nguyên do contra_pack tạo (mặc định res/assets.pak, không có thì dùng file rời)
+    // --headless [ticks]: chạy mô phỏng hết tốc độ, không mở cửa sổ/âm thanh rồi thoát
+    int tickRate = World::DEFAULT_TICK_RATE;
+    bool sweptCollision = true, headless = false, tileLayerMode = false, activityRegion = true, vsync = false, dynamicRes = false, simThreaded = true, hotReload = false;
+    int renderResW = 0, renderResH = 0;
+    long headlessTicks = HeadlessOptions().ticks;
+    string archivePath = AssetArchive::DEFAULT_PATH;
+    for (int i = 1; i < argc; ++i) {
+        string arg = args[i];
+        if (arg == "--headless") headless = true;
+        else if (arg == "--discrete") sweptCollision = false;
+        else if (arg == "--tile-layer") tileLayerMode = true;
+        else if (arg == "--full-sim") activityRegion = false;
+        else if (arg == "--vsync") vsync = true;
+        else if (arg == "--render-res" && i + 1 < argc) { if (sscanf(args[++i], "%dx%d", &renderResW, &renderResH) != 2) renderResW = renderResH = 0; }
+        else if (arg == "--dynamic-res") dynamicRes = true;
+        else if (arg == "--single-thread") simThreaded = false;
+        else if (arg == "--hot-reload") hotReload = true;
+        else if (arg == "--pack" && i + 1 < argc) archivePath = args[++i];
+        else if (arg == "--tick-rate" && i + 1 < argc) tickRate = atoi(args[++i]);
+        else if (headless && atol(args[i]) > 0) headlessTicks = atol(args[i]);
+    }
+    const float timeStep = World::timeStepForRate(tickRate);
+    const double launchTime = utils::hireTimeInSeconds();
+    if (headless) {
+        HeadlessOptions options;
+        options.ticks = headlessTicks;
+        options.timeStep = timeStep;
+        options.sweptCollision = sweptCollision;
+        options.activityRegion = activityRegion;
+        printHeadlessStats(runHeadless(options));
+        return 0;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) > 0) { cerr << "SDL_Init failed: " << SDL_GetError() << endl; return 1; }
     if (!IMG_Init(IMG_INIT_PNG)) { cerr << "IMG_Init failed: " << IMG_GetError() << endl; SDL_Quit(); return 1; }
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) { cerr << "SDL_mixer could not initialize! Mix_Error: " << Mix_GetError() << endl; IMG_Quit(); SDL_Quit(); return 1; }
+    if (Mix_OpenAudio(pack::AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, pack::AUDIO_CHANNELS, 2048) < 0) { cerr << "SDL_mixer could not initialize! Mix_Error: " << Mix_GetError() << endl; IMG_Quit(); SDL_Quit(); return 1; }
     if (TTF_Init() == -1) { cerr << "SDL_ttf could not initialize! TTF_Error: " << TTF_GetError() << endl; Mix_CloseAudio(); IMG_Quit(); SDL_Quit(); return 1; }
     cout << "SDL, IMG, Mixer, TTF initialized." << endl;
 
     const int SCREEN_WIDTH = 1024; const int SCREEN_HEIGHT = 672;
-    RenderWindow window("Contra Clone Reloaded", SCREEN_WIDTH, SCREEN_HEIGHT);
+    RenderWindow window("Contra Clone Reloaded", SCREEN_WIDTH, SCREEN_HEIGHT, vsync);
     int refreshRate = window.getRefreshRate(); if (refreshRate <= 0) refreshRate = 60;
-    cout << "Refresh Rate: " << refreshRate << endl;
+    // Có vsync thì SDL_RenderPresent đã giữ nhịp; không thì ngủ + quay vòng tới hạn của từng frame
+    FrameLimiter frameLimiter(window.hasVsync() ? 0.0 : refreshRate);
+    cout << "Refresh Rate: " << refreshRate << (window.hasVsync() ? " (vsync)" : "") << endl;
+    // Mặc định vẽ thẳng vào backbuffer; --dynamic-res không kèm --render-res lấy độ phân giải cửa sổ làm gốc
+    if (renderResW > 0 || dynamicRes) {
+        window.setInternalResolution(renderResW > 0 ? renderResW : SCREEN_WIDTH, renderResH > 0 ? renderResH : SCREEN_HEIGHT);
+        SDL_Point internalSize = window.getInternalSize();
+        cout << "Render resolution: " << internalSize.x << "x" << internalSize.y << endl;
+    }
+    // Ngân sách render 75% chu kỳ quét, phần còn lại cho mô phỏng và sai số của bộ giới hạn
+    ResolutionScaler* resolutionScaler = dynamicRes ? new ResolutionScaler(0.75 / refreshRate) : nullptr;
     SDL_Renderer* renderer = window.getRenderer(); 
 
-    TTF_Font* uiFont = TTF_OpenFont("res/font/kongtext.ttf", 24);
-    TTF_Font* menuFont = TTF_OpenFont("res/font/kongtext.ttf", 28);
-    TTF_Font* debugFont = TTF_OpenFont("res/font/kongtext.ttf", 16);
+    // Có archive thì ảnh, âm thanh và font lấy thẳng từ vùng map, không mở file rời và không giải mã
+    AssetArchive* archive = new AssetArchive();
+    if (archive->open(archivePath)) cout << "Asset archive: " << archivePath << " (" << archive->size() << " entries)" << endl;
+    auto openFont = [archive](const char* path, int ptsize) {
+        TTF_Font* font = archive->font(path, ptsize);
+        return font ? font : TTF_OpenFont(path, ptsize);
+    };
+    TTF_Font* uiFont = openFont("res/font/kongtext.ttf", 24);
+    TTF_Font* menuFont = openFont("res/font/kongtext.ttf", 28);
+    TTF_Font* debugFont = openFont("res/font/kongtext.ttf", 16);
     if (!uiFont || !menuFont || !debugFont) { cerr << "Font load error: " << TTF_GetError() << endl; Mix_CloseAudio();TTF_Quit();IMG_Quit();SDL_Quit(); return 1; }
     cout << "Fonts loaded." << endl;
-
-    SDL_Texture* menuBackgroundTexture = window.loadTexture("res/gfx/menu_background.png");
-    SDL_Texture* backgroundTexture = window.loadTexture("res/gfx/ContraMapStage1BG.png");
-    SDL_Texture* playerRunTexture = window.loadTexture("res/gfx/MainChar2.png");
-    SDL_Texture* playerJumpTexture = window.loadTexture("res/gfx/Jumping.png");
-    SDL_Texture* playerEnterWaterTexture = window.loadTexture("res/gfx/Watersplash.png");
-    SDL_Texture* playerSwimTexture = window.loadTexture("res/gfx/Diving.png");
-    SDL_Texture* playerStandAimShootHorizTexture = window.loadTexture("res/gfx/PlayerStandShoot.png");
-    SDL_Texture* playerRunAimShootHorizTexture = window.loadTexture("res/gfx/Shooting.png");
-    SDL_Texture* playerStandAimShootUpTexture = window.loadTexture("res/gfx/Shootingupward.png");
-    SDL_Texture* playerStandAimShootDiagUpTexture = window.loadTexture("res/gfx/PlayerAimDiagUp.png");
-    SDL_Texture* playerRunAimShootDiagUpTexture = window.loadTexture("res/gfx/PlayerShootDiagUp.png");
-    SDL_Texture* playerStandAimShootDiagDownTexture = window.loadTexture("res/gfx/PlayerAimDiagDown.png");
-    SDL_Texture* playerRunAimShootDiagDownTexture = window.loadTexture("res/gfx/PlayerShootDiagDown.png");
-    SDL_Texture* playerLyingDownTexture = window.loadTexture("res/gfx/PlayerLyingShoot.png"); 
-    SDL_Texture* playerLyingAimShootTexture = window.loadTexture("res/gfx/PlayerLyingShoot.png");
-    SDL_Texture* playerBulletTexture = window.loadTexture("res/gfx/WBullet.png");
-    SDL_Texture* turretBulletTexture = window.loadTexture("res/gfx/turret_bullet_sprite.png");
-    SDL_Texture* enemyTexture = window.loadTexture("res/gfx/Enemy.png");
-    SDL_Texture* gameTurretTexture = window.loadTexture("res/gfx/turret_texture.png");
-    SDL_Texture* turretExplosionTexture = window.loadTexture("res/gfx/turret_explosion_texture.png");
-    SDL_Texture* lifeMedalTexture = window.loadTexture("res/gfx/life_medal.png"); // ĐÃ THÊM Ở ĐÂY
-
-
-    Mix_Music* backgroundMusic = Mix_LoadMUS("res/snd/background_music.wav");
-    Mix_Chunk* shootSound = Mix_LoadWAV("res/snd/player_shoot.wav");
-    gEnemyDeathSound = Mix_LoadWAV("res/snd/enemy_death.wav");
-    gPlayerDeathSound = Mix_LoadWAV("res/snd/player_death_sound.wav");
-    gTurretExplosionSound = Mix_LoadWAV("res/snd/turret_explosion_sound.wav");
-    gTurretShootSound = Mix_LoadWAV("res/snd/turret_shoot_sound.wav");
-
-    bool loadError = false;
-    if (!menuBackgroundTexture || !backgroundTexture || !playerRunTexture || !playerJumpTexture ||
-        !playerEnterWaterTexture || !playerSwimTexture || !playerStandAimShootHorizTexture ||
-        !playerRunAimShootHorizTexture || !playerStandAimShootUpTexture || !playerStandAimShootDiagUpTexture ||
-        !playerRunAimShootDiagUpTexture || !playerStandAimShootDiagDownTexture || !playerRunAimShootDiagDownTexture ||
-        !playerLyingDownTexture || !playerLyingAimShootTexture ||
-        !playerBulletTexture || !turretBulletTexture || !enemyTexture || !gameTurretTexture || !turretExplosionTexture ||
-        !backgroundMusic || !shootSound || !gEnemyDeathSound || !gPlayerDeathSound ||
-        !gTurretExplosionSound || !gTurretShootSound || !lifeMedalTexture) { // ĐÃ THÊM KIỂM TRA lifeMedalTexture
-        loadError = true; cerr << "Error loading one or more resources!" << endl;
+    // Mỗi font/cỡ chữ một atlas glyph; chuỗi cố định được cache thành texture ở lần vẽ đầu
+    TextRenderer* uiText = new TextRenderer(renderer, uiFont);
+    TextRenderer* menuText = new TextRenderer(renderer, menuFont);
+    TextRenderer* debugText = new TextRenderer(renderer, debugFont);
+    SpriteBatch& spriteBatch = window.getSpriteBatch();
+
+    // Mọi ảnh và âm thanh đi qua AssetManager: giải mã song song trên worker, main thread chỉ upload. Ảnh menu
+    // xin đầu tiên để menu hiện ngay khi nó xong, phần còn lại tiếp tục load phía sau.
+    AssetManager* assets = new AssetManager(renderer, archive, hotReload);
+    gAssets = assets;
+    TextureHandle menuBackground = assets->texture("res/gfx/menu_background.png");
+    // Ảnh nền 9880 px chia dải ngay khi lấy surface nên không qua manager; chế độ tile layer không cần ảnh này
+    const char* STAGE_BACKGROUND_PATH = "res/gfx/ContraMapStage1BG.png";
+    SDL_Surface* stageSurface = tileLayerMode ? nullptr : archive->surface(STAGE_BACKGROUND_PATH);
+    int stageBackgroundAsset = tileLayerMode || stageSurface ? -1 : assets->loader().loadImage(STAGE_BACKGROUND_PATH, qoi::preferredFormat(renderer));
+    TextureHandle tileset = tileLayerMode ? assets->texture("res/gfx/Tileset.png") : TextureHandle();
+    // Sprite sheet của entity và HUD xếp chung vào trang atlas, kèm số cột để tính kích thước frame một lần.
+    // PlayerLyingShoot.png dùng làm hai sheet (1 và 3 cột) nhưng chỉ load và xếp một lần.
+    SpriteHandle playerRun = assets->sprite("res/gfx/MainChar2.png", 6);
+    SpriteHandle playerJump = assets->sprite("res/gfx/Jumping.png", 4);
+    SpriteHandle playerEnterWater = assets->sprite("res/gfx/Watersplash.png", 1);
+    SpriteHandle playerSwim = assets->sprite("res/gfx/Diving.png", 5);
+    SpriteHandle playerStandAimShootHoriz = assets->sprite("res/gfx/PlayerStandShoot.png", 1);
+    SpriteHandle playerRunAimShootHoriz = assets->sprite("res/gfx/Shooting.png", 3);
+    SpriteHandle playerStandAimShootUp = assets->sprite("res/gfx/Shootingupward.png", 2);
+    SpriteHandle playerStandAimShootDiagUp = assets->sprite("res/gfx/PlayerAimDiagUp.png", 1);
+    SpriteHandle playerRunAimShootDiagUp = assets->sprite("res/gfx/PlayerShootDiagUp.png", 3);
+    SpriteHandle playerStandAimShootDiagDown = assets->sprite("res/gfx/PlayerAimDiagDown.png", 1);
+    SpriteHandle playerRunAimShootDiagDown = assets->sprite("res/gfx/PlayerShootDiagDown.png", 3);
+    SpriteHandle playerLyingDown = assets->sprite("res/gfx/PlayerLyingShoot.png", 1);
+    SpriteHandle playerLyingAimShoot = assets->sprite("res/gfx/PlayerLyingShoot.png", 3);
+    SpriteHandle playerBullet = assets->sprite("res/gfx/WBullet.png");
+    SpriteHandle turretBullet = assets->sprite("res/gfx/turret_bullet_sprite.png");
+    SpriteHandle enemySheet = assets->sprite("res/gfx/Enemy.png", EnemyPool::NUM_FRAMES_WALK);
+    SpriteHandle turretSheet = assets->sprite("res/gfx/turret_texture.png", TurretPool::TURRET_SHEET_COLUMNS);
+    SpriteHandle turretExplosionSheet = assets->sprite("res/gfx/turret_explosion_texture.png", TurretPool::NUM_FRAMES_EXPLOSION);
+    SpriteHandle lifeMedal = assets->sprite("res/gfx/life_medal.png");
+    MusicHandle backgroundMusicHandle = assets->music("res/snd/background_music.wav");
+    gSoundEffects[static_cast<int>(SoundEffect::PLAYER_SHOOT)] = assets->sound("res/snd/player_shoot.wav");
+    gSoundEffects[static_cast<int>(SoundEffect::ENEMY_DEATH)] = assets->sound("res/snd/enemy_death.wav");
+    gSoundEffects[static_cast<int>(SoundEffect::PLAYER_DEATH)] = assets->sound("res/snd/player_death_sound.wav");
+    gSoundEffects[static_cast<int>(SoundEffect::TURRET_EXPLOSION)] = assets->sound("res/snd/turret_explosion_sound.wav");
+    gSoundEffects[static_cast<int>(SoundEffect::TURRET_SHOOT)] = assets->sound("res/snd/turret_shoot_sound.wav");
+    // Âm của player luôn nghe rõ và không bị turret cướp kênh; tiếng bắn của turret ưu tiên thấp nhất
+    VoiceManager* voices = new VoiceManager();
+    gVoices = voices;
+    voices->setRule(SoundEffect::PLAYER_DEATH, VoiceRule{ 1, 3, 1.0f, false });
+    voices->setRule(SoundEffect::PLAYER_SHOOT, VoiceRule{ 2, 2, 0.8f, false });
+    voices->setRule(SoundEffect::TURRET_EXPLOSION, VoiceRule{ 3, 2, 1.0f, true });
+    voices->setRule(SoundEffect::ENEMY_DEATH, VoiceRule{ 3, 1, 0.9f, true });
+    voices->setRule(SoundEffect::TURRET_SHOOT, VoiceRule{ 3, 0, 0.6f, true });
+
+    // Màn hình loading: thanh tiến độ trên nền đen, có ảnh menu thì vẽ lên ảnh menu, tới khi mọi job xong
+    bool quitRequested = false;
+    double firstFrameTime = 0.0;
+    while (!quitRequested && !assets->loadingDone()) {
+        SDL_Event loadEvent;
+        while (SDL_PollEvent(&loadEvent)) {
+            if (loadEvent.type == SDL_QUIT || (loadEvent.type == SDL_KEYDOWN && loadEvent.key.keysym.sym == SDLK_ESCAPE)) quitRequested = true;
+        }
+        window.clear();
+        if (SDL_Texture* menuTexture = assets->get(menuBackground)) SDL_RenderCopy(renderer, menuTexture, NULL, NULL);
+        const int BAR_WIDTH = SCREEN_WIDTH / 2, BAR_HEIGHT = 12, BAR_Y = SCREEN_HEIGHT - 60;
+        SDL_Rect barOutline = { (SCREEN_WIDTH - BAR_WIDTH) / 2, BAR_Y, BAR_WIDTH, BAR_HEIGHT };
+        SDL_Rect barFill = { barOutline.x, BAR_Y, static_cast<int>(BAR_WIDTH * assets->progress()), BAR_HEIGHT };
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        SDL_RenderDrawRect(renderer, &barOutline);
+        SDL_RenderFillRect(renderer, &barFill);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // clear() xóa bằng màu vẽ hiện tại
+        char loadingText[32];
+        snprintf(loadingText, sizeof(loadingText), "LOADING %d%%", static_cast<int>(assets->progress() * 100.0f));
+        menuText->draw(spriteBatch, loadingText, (SCREEN_WIDTH - menuText->measure(loadingText)) / 2, BAR_Y - menuText->lineHeight() - 20, SDL_Color{ 255, 255, 255, 255 });
+        window.flushSprites();
+        window.display();
+        if (firstFrameTime == 0.0) firstFrameTime = utils::hireTimeInSeconds();
+        frameLimiter.wait();
+    }
+    // Thoát giữa chừng vẫn chờ hết kết quả để phần dọn dẹp phía dưới chạy như bình thường
+    ChunkedBackground* stageBackground = tileLayerMode ? nullptr : new ChunkedBackground(renderer, stageSurface ? stageSurface : assets->loader().takeSurface(stageBackgroundAsset));
+    const int assetFiles = assets->fileCount(), assetWorkers = assets->workerCount();
+    bool assetsBuilt = assets->build();
+    SDL_Texture* tilesetTexture = assets->get(tileset);
+    Mix_Music* backgroundMusic = assets->get(backgroundMusicHandle);
+    SpriteRegion lifeMedalSprite = assets->sheet(lifeMedal).region;
+    const double loadedTime = utils::hireTimeInSeconds();
+    cout << "Assets: " << assetFiles << " files on " << assetWorkers << " worker(s)" << (archive->isOpen() ? ", the rest mapped from the archive" : "") << ", first frame after "
+         << static_cast<int>((firstFrameTime - launchTime) * 1000.0) << " ms, loaded after " << static_cast<int>((loadedTime - launchTime) * 1000.0) << " ms" << endl;
+
+    if (!assetsBuilt || !assets->get(menuBackground) || (stageBackground ? !stageBackground->isLoaded() : !tilesetTexture)) {
+        cerr << "Error loading one or more resources!" << endl;
+        delete stageBackground; gVoices = nullptr; delete voices; gAssets = nullptr; delete assets; delete archive;
+        Mix_CloseAudio(); TTF_Quit(); IMG_Quit(); SDL_Quit(); return 1;
     }
-    if (loadError) { Mix_CloseAudio(); TTF_Quit(); IMG_Quit(); SDL_Quit(); return 1; }
     cout << "Resources loaded." << endl;
+    HudLayer* hudLayer = new HudLayer(renderer, SCREEN_WIDTH, SCREEN_HEIGHT, uiText, menuText, lifeMedalSprite);
+
+    TileMap stageMap(mapData, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT);
+    TileLayer* tileLayer = tileLayerMode ? new TileLayer(renderer, tilesetTexture, stageMap) : nullptr;
+    // Giới hạn camera: bề rộng ảnh nền, hoặc bề rộng map khi vẽ bằng tile
+    const int BG_TEXTURE_WIDTH = stageBackground ? stageBackground->getWidth() : stageMap.getCols() * LOGICAL_TILE_WIDTH;
+
+    WorldTextures worldTextures;
+    worldTextures.enemy = assets->sheet(enemySheet);
+    worldTextures.turret = assets->sheet(turretSheet);
+    worldTextures.turretExplosion = assets->sheet(turretExplosionSheet);
+    worldTextures.turretBullet = assets->sheet(turretBullet).region;
+    worldTextures.playerBullet = assets->sheet(playerBullet).region;
+    World world(stageMap, worldTextures);
+    world.sweptCollision = sweptCollision;
+    world.activityRegion = activityRegion;
+
+    vector2d initialPos = {World::PLAYER_START_X, World::PLAYER_START_Y};
+    PlayerSprites playerSprites;
+    playerSprites.run = assets->sheet(playerRun);
+    playerSprites.jump = assets->sheet(playerJump);
+    playerSprites.enterWater = assets->sheet(playerEnterWater);
+    playerSprites.swim = assets->sheet(playerSwim);
+    playerSprites.standAimShootHoriz = assets->sheet(playerStandAimShootHoriz);
+    playerSprites.runAimShootHoriz = assets->sheet(playerRunAimShootHoriz);
+    playerSprites.standAimShootUp = assets->sheet(playerStandAimShootUp);
+    playerSprites.standAimShootDiagUp = assets->sheet(playerStandAimShootDiagUp);
+    playerSprites.runAimShootDiagUp = assets->sheet(playerRunAimShootDiagUp);
+    playerSprites.standAimShootDiagDown = assets->sheet(playerStandAimShootDiagDown);
+    playerSprites.runAimShootDiagDown = assets->sheet(playerRunAimShootDiagDown);
+    playerSprites.lyingDown = assets->sheet(playerLyingDown);
+    playerSprites.lyingAimShoot = assets->sheet(playerLyingAimShoot);
+    Player* player_ptr = new Player(initialPos, playerSprites,
+                                    World::PLAYER_STANDARD_FRAME_W, World::PLAYER_STANDARD_FRAME_H,
+                                    World::PLAYER_LYING_FRAME_W, World::PLAYER_LYING_FRAME_H);
+    player_ptr->setInvulnerable(false);
+
+    // Từ đây World và Player thuộc về thread mô phỏng: main thread chỉ gửi SimInput và vẽ RenderSnapshot
+    SimThread* sim = new SimThread(world, *player_ptr, timeStep, SCREEN_WIDTH, static_cast<float>(BG_TEXTURE_WIDTH - SCREEN_WIDTH), simThreaded);
 
-    int BG_TEXTURE_WIDTH = 0, BG_TEXTURE_HEIGHT = 0;
-    if(backgroundTexture) SDL_QueryTexture(backgroundTexture, NULL, NULL, &BG_TEXTURE_WIDTH, &BG_TEXTURE_HEIGHT);
-
-    const int PLAYER_STANDARD_FRAME_W = 40; const int PLAYER_STANDARD_FRAME_H = 78;
-    const int PLAYER_LYING_FRAME_W = 78; const int PLAYER_LYING_FRAME_H = 40;
-    const int PLAYER_RUN_SHEET_COLS = 6; const int PLAYER_JUMP_SHEET_COLS = 4;
-    const int PLAYER_ENTER_WATER_SHEET_COLS = 1; const int PLAYER_SWIM_SHEET_COLS = 5;
-    const int PLAYER_STAND_AIM_SHOOT_HORIZ_SHEET_COLS = 1; const int PLAYER_RUN_AIM_SHOOT_HORIZ_SHEET_COLS = 3;
-    const int PLAYER_STAND_AIM_SHOOT_UP_SHEET_COLS = 2;
-    const int PLAYER_STAND_AIM_SHOOT_DIAG_UP_SHEET_COLS = 1;
-    const int PLAYER_RUN_AIM_SHOOT_DIAG_UP_SHEET_COLS = 3;
-    const int PLAYER_STAND_AIM_SHOOT_DIAG_DOWN_SHEET_COLS = 1;
-    const int PLAYER_RUN_AIM_SHOOT_DIAG_DOWN_SHEET_COLS = 3;
-    const int PLAYER_LYING_DOWN_SHEET_COLS = 1; const int PLAYER_LYING_AIM_SHOOT_SHEET_COLS = 3;
-    const int PLAYER_BULLET_RENDER_WIDTH = 12; // Kích thước đạn người chơi
-    const int PLAYER_BULLET_RENDER_HEIGHT = 6;  // Kích thước đạn người chơi
-    
-    const float INITIAL_CAMERA_X = 0.0f, INITIAL_CAMERA_Y = 0.0f;
-    const float PLAYER_START_X = 100.0f; const float PLAYER_START_Y = 300.0f; 
-    const float PLAYER_RESPAWN_OFFSET_X = 150.0f;
-
-    float cameraX = INITIAL_CAMERA_X, cameraY = INITIAL_CAMERA_Y;
     GameState currentGameState = GameState::MAIN_MENU;
-    Player* player_ptr = nullptr; 
-    list<Bullet> playerBulletsList; list<Bullet> enemyBulletsList;
-    list<Enemy> enemies_list; list<Turret> turrets_list;
-    int playerScore = 0; float gameWinConditionX = 0.0f;
-    bool gameRunning = true, isPaused = false, gameWonFlag = false, isMusicPlaying = false;
-    const float timeStep = 0.01f; float accumulator = 0.0f;
-    float currentTime_game = static_cast<float>(utils::hireTimeInSeconds());
+    bool gameRunning = !quitRequested, isPaused = false, isMusicPlaying = false;
+    std::uint32_t session = 0;        // Lượt chơi hiện tại, snapshot của lượt khác thì không vẽ
+    std::uint32_t sentKeys = 0xFFFFFFFFu; // Mask phím gửi lần cuối, giá trị không hợp lệ để buộc gửi lại
     SDL_Event event;
 
     auto initializeGame = [&]() {
         cout << "Initializing Game State..." << endl;
-        playerBulletsList.clear(); enemyBulletsList.clear(); enemies_list.clear(); turrets_list.clear();
-        playerScore = 0;
-        vector2d initialPos = {PLAYER_START_X, PLAYER_START_Y};
-
-        if (player_ptr) {
-            player_ptr->resetPlayerStateForNewGame();
-            player_ptr->setPos(initialPos);
-            player_ptr->setInvulnerable(false); 
-        } else {
-            player_ptr = new Player(
-                initialPos,
-                playerRunTexture, PLAYER_RUN_SHEET_COLS, playerJumpTexture, PLAYER_JUMP_SHEET_COLS,
-                playerEnterWaterTexture, PLAYER_ENTER_WATER_SHEET_COLS, playerSwimTexture, PLAYER_SWIM_SHEET_COLS,
-                playerStandAimShootUpTexture, PLAYER_STAND_AIM_SHOOT_UP_SHEET_COLS,
-                playerStandAimShootDiagUpTexture, PLAYER_STAND_AIM_SHOOT_DIAG_UP_SHEET_COLS,
-                playerStandAimShootDiagDownTexture, PLAYER_STAND_AIM_SHOOT_DIAG_DOWN_SHEET_COLS,
-                playerRunAimShootDiagUpTexture, PLAYER_RUN_AIM_SHOOT_DIAG_UP_SHEET_COLS,
-                playerRunAimShootDiagDownTexture, PLAYER_RUN_AIM_SHOOT_DIAG_DOWN_SHEET_COLS,
-                playerStandAimShootHorizTexture, PLAYER_STAND_AIM_SHOOT_HORIZ_SHEET_COLS,
-                playerRunAimShootHorizTexture, PLAYER_RUN_AIM_SHOOT_HORIZ_SHEET_COLS,
-                playerLyingDownTexture, PLAYER_LYING_DOWN_SHEET_COLS,
-                playerLyingAimShootTexture, PLAYER_LYING_AIM_SHOOT_SHEET_COLS,
-                PLAYER_STANDARD_FRAME_W, PLAYER_STANDARD_FRAME_H,
-                PLAYER_LYING_FRAME_W, PLAYER_LYING_FRAME_H
-            );
-             player_ptr->setInvulnerable(false); 
-        }
-
-        cameraX = INITIAL_CAMERA_X; cameraY = INITIAL_CAMERA_Y;
-        gameWonFlag = false; isPaused = false;
-
-        auto spawnEnemy = [&](float wx, int gr){ float eh=72.f; float gy=static_cast<float>(gr*LOGICAL_TILE_HEIGHT); float sy=gy-eh; enemies_list.emplace_back(vector2d{wx, sy}, enemyTexture); };
-        spawnEnemy(8.0f*LOGICAL_TILE_WIDTH, 3); spawnEnemy(15.0f*LOGICAL_TILE_WIDTH, 3); spawnEnemy(40.0f*LOGICAL_TILE_WIDTH, 2);
-        for (size_t r = 0; r < mapData.size(); ++r) { for (size_t c = 0; c < mapData[r].size(); ++c) { if (mapData[r][c] == 4) { float tx=static_cast<float>(c*LOGICAL_TILE_WIDTH); float ty=static_cast<float>(r*LOGICAL_TILE_HEIGHT); turrets_list.emplace_back(vector2d{tx, ty}, gameTurretTexture, turretExplosionTexture, gTurretExplosionSound, gTurretShootSound, turretBulletTexture, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT); } } }
-        cout << "Game Initialized. Spawned " << enemies_list.size() << " troops and " << turrets_list.size() << " turrets." << endl;
+        sim->pushInput(SimInput{ SimInput::Type::START, static_cast<std::int32_t>(++session) });
+        sentKeys = 0xFFFFFFFFu;
+        isPaused = false;
 
         if (!Mix_PlayingMusic()) { if (Mix_PlayMusic(backgroundMusic, -1) == -1) { cerr << "Mix_PlayMusic Error: " << Mix_GetError() << endl; } else isMusicPlaying = true; }
         else if (!isMusicPlaying) { Mix_ResumeMusic(); isMusicPlaying = true; }
     };
 
-    int mapRows = mapData.size();
-    int mapCols = (mapRows > 0) ? mapData[0].size() : 0;
+    int mapRows = stageMap.getRows();
+    int mapCols = stageMap.getCols();
     if (mapCols == 0) { cerr << "Error: mapData is empty!" << endl; return 1; }
+    if (!world.isMapSupported()) return 1; // World đã in lỗi
     cout << "Map: " << mapRows << "x" << mapCols << endl;
-    gameWinConditionX = static_cast<float>((mapCols > 3 ? mapCols - 3 : (mapCols > 0 ? mapCols -1 : 0)) * LOGICAL_TILE_WIDTH);
-    cout << "Win condition X: " << gameWinConditionX << endl;
+    cout << "Win condition X: " << world.winConditionX << endl;
+    sim->start();
+    cout << "Simulation: " << (sim->isThreaded() ? "own thread" : "main thread") << endl;
 
     while(gameRunning) {
-        int startTicks = SDL_GetTicks();
-        float newTime = static_cast<float>(utils::hireTimeInSeconds());
-        float frameTime = newTime - currentTime_game; if(frameTime > 0.25f) frameTime = 0.25f; currentTime_game = newTime;
-
+        // Ô atlas và texture được ghi đè tại chỗ, chỉ các lớp đã bake (tile, HUD) phải vẽ lại
+        if (hotReload && assets->pollChanges(SimThread::clockSeconds()) > 0) { if (tileLayer) tileLayer->markAllDirty(); hudLayer->markDirty(); }
         while(SDL_PollEvent(&event)) {
              if(event.type == SDL_QUIT) { gameRunning = false; }
+             if(event.type == SDL_RENDER_TARGETS_RESET) { if (tileLayer) tileLayer->markAllDirty(); hudLayer->markDirty(); } // Texture đã bake bị mất nội dung
              switch (currentGameState) {
                 case GameState::MAIN_MENU: if (event.type == SDL_KEYDOWN) { if (event.key.keysym.sym == SDLK_RETURN || event.key.keysym.sym == SDLK_KP_ENTER) { currentGameState = GameState::PLAYING; initializeGame(); } else if (event.key.keysym.sym == SDLK_ESCAPE) { gameRunning = false; } } break;
-                case GameState::PLAYING: if (event.type == SDL_KEYDOWN) { if (event.key.keysym.sym == SDLK_p && !event.key.repeat) { isPaused = !isPaused; if (isPaused) { if(isMusicPlaying && Mix_PlayingMusic()) Mix_PauseMusic(); } else { if(isMusicPlaying && Mix_PausedMusic()) Mix_ResumeMusic(); } cout << (isPaused ? "PAUSED" : "RESUMED") << endl; } else if (event.key.keysym.sym == SDLK_m && !event.key.repeat) { isMusicPlaying = !isMusicPlaying; if (isMusicPlaying){ if(!Mix_PlayingMusic()) Mix_PlayMusic(backgroundMusic,-1); else if(Mix_PausedMusic()) Mix_ResumeMusic(); cout<<"Music On"<<endl;} else { if(Mix_PlayingMusic()) Mix_PauseMusic(); cout<<"Music Off"<<endl;} } else if (!isPaused && player_ptr) { player_ptr->handleKeyDown(event.key.keysym.sym); } if (event.key.keysym.sym == SDLK_ESCAPE) { gameRunning = false; } } break;
+                case GameState::PLAYING: if (event.type == SDL_KEYDOWN) { if (event.key.keysym.sym == SDLK_p && !event.key.repeat) { isPaused = !isPaused; sim->pushInput(SimInput{ isPaused ? SimInput::Type::PAUSE : SimInput::Type::RESUME, 0 }); if (isPaused) { if(isMusicPlaying && Mix_PlayingMusic()) Mix_PauseMusic(); } else { if(isMusicPlaying && Mix_PausedMusic()) Mix_ResumeMusic(); } cout << (isPaused ? "PAUSED" : "RESUMED") << endl; } else if (event.key.keysym.sym == SDLK_m && !event.key.repeat) { isMusicPlaying = !isMusicPlaying; if (isMusicPlaying){ if(!Mix_PlayingMusic()) Mix_PlayMusic(backgroundMusic,-1); else if(Mix_PausedMusic()) Mix_ResumeMusic(); cout<<"Music On"<<endl;} else { if(Mix_PlayingMusic()) Mix_PauseMusic(); cout<<"Music Off"<<endl;} } else if (!isPaused) { sim->pushInput(SimInput{ SimInput::Type::KEY_DOWN, static_cast<std::int32_t>(event.key.keysym.sym) }); } if (event.key.keysym.sym == SDLK_ESCAPE) { gameRunning = false; } } break;
                  case GameState::WON: case GameState::GAME_OVER: if (event.type == SDL_KEYDOWN) { if (event.key.keysym.sym == SDLK_ESCAPE) { gameRunning = false; } else if (event.key.keysym.sym == SDLK_RETURN || event.key.keysym.sym == SDLK_KP_ENTER) { currentGameState = GameState::MAIN_MENU; } } break;
              }
         }
 
         if (currentGameState == GameState::PLAYING && !isPaused) {
-            accumulator += frameTime;
-            const Uint8* currentKeyStates = SDL_GetKeyboardState(NULL); if(player_ptr) player_ptr->handleInput(currentKeyStates);
-            while(accumulator >= timeStep) {
-                 if(player_ptr) { player_ptr->update(timeStep, mapData, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT); player_ptr->getPos().x = std::max(cameraX, player_ptr->getPos().x); }
-                for (Enemy& e : enemies_list) e.update(timeStep, mapData, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT);
-                for (Turret& t : turrets_list) t.update(timeStep, player_ptr, enemyBulletsList);
-                for (auto it_b = playerBulletsList.begin(); it_b != playerBulletsList.end(); ) { 
-                    it_b->update(timeStep); 
-                    if (!it_b->isActive()) { 
-                        it_b = playerBulletsList.erase(it_b); 
-                        continue; 
-                    } 
-                    SDL_Rect bHB = it_b->getWorldHitbox(); 
-                    bool hit = false; 
-                    for (auto it_e = enemies_list.begin(); it_e != enemies_list.end(); ++it_e) { 
-                        if (it_e->isAlive()) { 
-                            SDL_Rect eHB = it_e->getWorldHitbox(); 
-                            if (SDL_HasIntersection(&bHB, &eHB)) { 
-                                bool wasA = it_e->isAlive(); 
-                                it_e->takeHit(); 
-                                if(wasA && !it_e->isAlive()) playerScore+=200; 
-                                it_b->setActive(false); 
-                                hit = true; 
-                                break; 
-                            } 
-                        } 
-                    } 
-                    if (hit) { 
-                        it_b = playerBulletsList.erase(it_b); 
-                        continue; 
-                    } 
-                    for (auto it_t = turrets_list.begin(); it_t != turrets_list.end(); ++it_t) { 
-                        if (it_t->getHp() > 0) { // Chỉ va chạm với Turret còn sống
-                            SDL_Rect tHB = it_t->getWorldHitbox(); 
-                            if (SDL_HasIntersection(&bHB, &tHB)) { 
-                                int hpB=it_t->getHp(); 
-                                it_t->takeDamage(); 
-                                if(hpB>0 && it_t->getHp()<=0) playerScore+=500; 
-                                it_b->setActive(false); 
-                                hit = true; 
-                                break; 
-                            } 
-                        } 
-                    } 
-                    if (hit) { 
-                        it_b = playerBulletsList.erase(it_b); 
-                        continue; 
-                    } 
-                    // SỬA ĐỔI: XÓA HOẶC COMMENT OUT DÒNG NÀY
-                    // if (!hit) { 
-                    //    it_b->checkMapCollision(mapData, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT); 
-                    // } 
-                    
-                    if (!it_b->isActive()) { // Kiểm tra lại active sau khi các va chạm (nếu có)
-                        it_b = playerBulletsList.erase(it_b); 
-                    } else { 
-                        ++it_b; 
-                    } 
-                }
-
-                // Enemy Bullets Collisions...
-                for (auto it_eb = enemyBulletsList.begin(); it_eb != enemyBulletsList.end(); ) { 
-                    it_eb->update(timeStep); 
-                    if (!it_eb->isActive()) { 
-                        it_eb = enemyBulletsList.erase(it_eb); 
-                        continue; 
-                    } 
-                    if (player_ptr && !player_ptr->getIsDead() && !player_ptr->isInvulnerable()) { 
-                        SDL_Rect ebHB = it_eb->getWorldHitbox(); 
-                        SDL_Rect pHB = player_ptr->getWorldHitbox(); 
-                        if (SDL_HasIntersection(&ebHB, &pHB)) { 
-                            bool wasA=!player_ptr->getIsDead(); 
-                            player_ptr->takeHit(false); 
-                            if(gPlayerDeathSound && wasA && player_ptr->getIsDead()) Mix_PlayChannel(-1, gPlayerDeathSound, 0); 
-                            it_eb->setActive(false); 
-                        } 
-                    } 
-                    // SỬA ĐỔI: XÓA HOẶC COMMENT OUT DÒNG NÀY
-                    // if (it_eb->isActive()) { 
-                    //    it_eb->checkMapCollision(mapData, LOGICAL_TILE_WIDTH, LOGICAL_TILE_HEIGHT); 
-                    // } 
-                    
-                    if (!it_eb->isActive()) { // Kiểm tra lại active sau khi các va chạm (nếu có)
-                        it_eb = enemyBulletsList.erase(it_eb); 
-                    } else { 
-                        ++it_eb; 
-                    } 
-                }
-                accumulator -= timeStep;
-            }
-            enemies_list.remove_if([](const Enemy& e){ return e.isDead(); }); turrets_list.remove_if([](const Turret& t){ return t.isFullyDestroyed(); });
-
-            if (player_ptr && player_ptr->getCurrentState() == PlayerState::DEAD) {
-                if (player_ptr->getLives() > 0) {
-                    player_ptr->respawn(cameraX, PLAYER_START_Y, PLAYER_RESPAWN_OFFSET_X);
-                }
-                else { currentGameState = GameState::GAME_OVER; if(isMusicPlaying && Mix_PlayingMusic()) { Mix_HaltMusic(); isMusicPlaying = false; } cout << "--- GAME OVER --- Final Score: " << playerScore << endl; }
-            } else if (player_ptr && !player_ptr->getIsDead() && player_ptr->getPos().x + PLAYER_STANDARD_FRAME_W/2.0f >= gameWinConditionX && !gameWonFlag ) {
-                 currentGameState = GameState::WON; gameWonFlag = true; if(isMusicPlaying && Mix_PlayingMusic()) { Mix_HaltMusic(); isMusicPlaying = false; } cout << "--- YOU WIN --- Final Score: " << playerScore << endl;
-            }
-            if (player_ptr) { 
-                vector2d bs, bv; 
-                if (player_ptr->wantsToShoot(bs, bv)) { 
-                    playerBulletsList.emplace_back(bs, bv, playerBulletTexture, 
-                                                   PLAYER_BULLET_RENDER_WIDTH, PLAYER_BULLET_RENDER_HEIGHT); 
-                    if(shootSound) Mix_PlayChannel(-1, shootSound, 0); 
-                } 
+            // Phím đang giữ chỉ gửi khi đổi; mô phỏng giữ trạng thái và đưa vào handleInput mỗi tick
+            const Uint8* currentKeyStates = SDL_GetKeyboardState(NULL);
+            std::uint32_t keys = (currentKeyStates[SDL_SCANCODE_LEFT] ? SimInput::KEY_LEFT : 0u) | (currentKeyStates[SDL_SCANCODE_RIGHT] ? SimInput::KEY_RIGHT : 0u) |
+                                 (currentKeyStates[SDL_SCANCODE_UP] ? SimInput::KEY_UP : 0u) | (currentKeyStates[SDL_SCANCODE_DOWN] ? SimInput::KEY_DOWN : 0u) |
+                                 (currentKeyStates[SDL_SCANCODE_F] ? SimInput::KEY_SHOOT : 0u);
+            if (keys != sentKeys && sim->pushInput(SimInput{ SimInput::Type::KEYS, static_cast<std::int32_t>(keys) })) sentKeys = keys;
+        }
+        sim->pump();
+
+        // Vẽ ở vị trí nội suy giữa tick trước và tick mới nhất theo thời gian đã trôi kể từ lúc tick đó đến hạn:
+        // nhịp tick khác tần số quét không bị giật
+        const RenderSnapshot& snapshot = sim->latestSnapshot();
+        const bool haveSnapshot = snapshot.session == session && session != 0;
+        const float alpha = utils::clamp(static_cast<float>((SimThread::clockSeconds() - snapshot.tickTime) / timeStep), 0.0f, 1.0f);
+        const float cameraX = utils::lerp(snapshot.prevCameraX, snapshot.cameraX, alpha), cameraY = utils::lerp(snapshot.prevCameraY, snapshot.cameraY, alpha);
+
+        // Âm thanh pan/giảm theo khung nhìn đang vẽ
+        if (haveSnapshot) voices->setListener(cameraX, static_cast<float>(SCREEN_WIDTH));
+        SimEvent simEvent;
+        while (sim->pollEvent(simEvent)) {
+            switch (simEvent.type) {
+                case SimEvent::Type::SOUND: playSoundEffect(static_cast<SoundEffect>(simEvent.value), simEvent.x, simEvent.tick); break;
+                case SimEvent::Type::GAME_OVER:
+                    currentGameState = GameState::GAME_OVER; if(isMusicPlaying && Mix_PlayingMusic()) { Mix_HaltMusic(); isMusicPlaying = false; } cout << "--- GAME OVER --- Final Score: " << simEvent.value << endl;
+                    break;
+                case SimEvent::Type::WON:
+                    currentGameState = GameState::WON; if(isMusicPlaying && Mix_PlayingMusic()) { Mix_HaltMusic(); isMusicPlaying = false; } cout << "--- YOU WIN --- Final Score: " << simEvent.value << endl;
+                    break;
             }
-            if(player_ptr && !player_ptr->getIsDead()){ SDL_Rect pHB = player_ptr->getWorldHitbox(); float pCX = static_cast<float>(pHB.x + pHB.w / 2.0f); float tCX = pCX - static_cast<float>(SCREEN_WIDTH) / 2.5f; if (tCX > cameraX) { cameraX = tCX; } }
         }
 
-         if(currentGameState != GameState::MAIN_MENU){ cameraX = std::max(0.0f, cameraX); if (BG_TEXTURE_WIDTH > SCREEN_WIDTH) cameraX = std::min(cameraX, static_cast<float>(BG_TEXTURE_WIDTH - SCREEN_WIDTH)); else cameraX = 0.0f; }
-
         window.clear();
         switch (currentGameState) {
-            case GameState::MAIN_MENU: { SDL_RenderCopy(renderer, menuBackgroundTexture, NULL, NULL); SDL_Color tc={255,255,255,255}; string t="PRESS ENTER TO START"; SDL_Surface* s=TTF_RenderText_Solid(menuFont,t.c_str(),tc); if(s){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,s); if(tx){ SDL_Rect d={(SCREEN_WIDTH-s->w)/2, SCREEN_HEIGHT-s->h-80, s->w, s->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); } SDL_FreeSurface(s);} } break;
+            case GameState::MAIN_MENU: { SDL_RenderCopy(renderer, assets->get(menuBackground), NULL, NULL); SDL_Color tc={255,255,255,255}; const char* t="PRESS ENTER TO START"; SDL_Point sz=menuText->staticSize(t,tc); menuText->drawStatic(spriteBatch, t, (SCREEN_WIDTH-sz.x)/2, SCREEN_HEIGHT-sz.y-80, tc); } break;
             case GameState::PLAYING: case GameState::WON: case GameState::GAME_OVER: { 
-                SDL_Rect bgSrc={static_cast<int>(round(cameraX)), static_cast<int>(round(cameraY)), SCREEN_WIDTH, SCREEN_HEIGHT}; SDL_Rect bgDst={0,0,SCREEN_WIDTH,SCREEN_HEIGHT}; if(backgroundTexture) SDL_RenderCopy(renderer, backgroundTexture, &bgSrc, &bgDst);
+                if (!haveSnapshot) break; // Mô phỏng chưa nhận START của lượt này
+                if (stageBackground) {
+                    stageBackground->update(cameraX, SCREEN_WIDTH);
+                    stageBackground->render(cameraX, cameraY, SCREEN_WIDTH, SCREEN_HEIGHT);
+                } else if (tileLayer) {
+                    tileLayer->render(cameraX, cameraY, SCREEN_WIDTH, SCREEN_HEIGHT);
+                }
 
                 #ifdef DEBUG_DRAW_GRID
                 if (renderer) { 
@@ -341,7 +362,7 @@ int main(int argc, char* args[]) {
                 #endif 
 
                  #ifdef DEBUG_DRAW_COLUMNS
-                if (renderer && debugFont) {
+                if (renderer && debugText->isLoaded()) {
                     SDL_Color textColor = {255, 255, 0, 255}; 
                     int startCol = static_cast<int>(floor(cameraX / LOGICAL_TILE_WIDTH));
                     int endCol = startCol + static_cast<int>(ceil(static_cast<float>(SCREEN_WIDTH) / LOGICAL_TILE_WIDTH)) + 1;
@@ -359,98 +380,47 @@ int main(int argc, char* args[]) {
                                 screenY + LOGICAL_TILE_HEIGHT < 0 || screenY > SCREEN_HEIGHT) {
                                 continue;
                             }
-                            string tileText = std::to_string(mapData[r][c]); 
-                            SDL_Surface* surface = TTF_RenderText_Solid(debugFont, tileText.c_str(), textColor);
-                            if (surface) {
-                                SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-                                if (texture) {
-                                    int textX = screenX + (LOGICAL_TILE_WIDTH - surface->w) / 2;
-                                    int textY = screenY + (LOGICAL_TILE_HEIGHT - surface->h) / 2;
-                                    SDL_Rect dstRect = {textX, textY, surface->w, surface->h};
-                                    SDL_RenderCopy(renderer, texture, NULL, &dstRect);
-                                    SDL_DestroyTexture(texture);
-                                }
-                                SDL_FreeSurface(surface);
-                            }
+                            char tileText[12];
+                            snprintf(tileText, sizeof(tileText), "%d", stageMap.tileAt(c, r));
+                            int textX = screenX + (LOGICAL_TILE_WIDTH - debugText->measure(tileText)) / 2;
+                            int textY = screenY + (LOGICAL_TILE_HEIGHT - debugText->lineHeight()) / 2;
+                            debugText->draw(spriteBatch, tileText, textX, textY, textColor);
                         }
                     }
                 }
                 #endif 
 
-                for (Enemy& e : enemies_list) e.render(window, cameraX, cameraY);
-                for (Turret& t : turrets_list) t.render(window, cameraX, cameraY);
-                for (Bullet& b : playerBulletsList) b.render(window, cameraX, cameraY);
-                for (Bullet& eb : enemyBulletsList) eb.render(window, cameraX, cameraY);
-                if (player_ptr) player_ptr->render(window, cameraX, cameraY);
-
-                // Draw UI
-                if (uiFont && renderer) { 
-                    SDL_Color c = {255,255,255,255}; 
-                    string sTxt = "SCORE: " + std::to_string(playerScore); 
-                    SDL_Surface* sS = TTF_RenderText_Solid(uiFont, sTxt.c_str(), c); 
-                    if(sS){
-                        SDL_Texture* tS=SDL_CreateTextureFromSurface(renderer,sS); 
-                        SDL_Rect dS={10,10,sS->w,sS->h}; 
-                        SDL_RenderCopy(renderer,tS,NULL,&dS); 
-                        SDL_DestroyTexture(tS); 
-                        SDL_FreeSurface(sS);
-                    }
-                    
-                    // --- PHẦN VẼ HUÂN CHƯƠNG ĐÃ ĐƯỢC THÊM VÀO ĐÂY ---
-                    if (player_ptr && lifeMedalTexture) {
-                        int livesLeft = player_ptr->getLives();
-                        if (livesLeft > 0) { // Chỉ vẽ nếu còn mạng
-                            int medalSpriteWidth = 0;  
-                            int medalSpriteHeight = 0; 
-                            SDL_QueryTexture(lifeMedalTexture, NULL, NULL, &medalSpriteWidth, &medalSpriteHeight);
-
-                            // Kích thước bạn muốn render mỗi huân chương
-                            const int MEDAL_RENDER_WIDTH = 20; // Ví dụ: Dùng kích thước gốc của texture
-                            const int MEDAL_RENDER_HEIGHT = 40;
-                            // Hoặc nếu bạn muốn kích thước cố định, ví dụ:
-                            // const int MEDAL_RENDER_WIDTH = 24; 
-                            // const int MEDAL_RENDER_HEIGHT = 24;
-
-                            int spacingBetweenMedals = 5; 
-                            int topMargin = 10;           
-                            int rightMargin = 10;         
-
-                            for (int i = 0; i < livesLeft; ++i) {
-                                SDL_Rect destRectMedal;
-                                destRectMedal.x = SCREEN_WIDTH - rightMargin - (i + 1) * MEDAL_RENDER_WIDTH - i * spacingBetweenMedals;
-                                destRectMedal.y = topMargin;
-                                destRectMedal.w = MEDAL_RENDER_WIDTH;
-                                destRectMedal.h = MEDAL_RENDER_HEIGHT;
-                                SDL_RenderCopy(renderer, lifeMedalTexture, NULL, &destRectMedal); 
-                            }
-                        }
-                    }
-                    // --- KẾT THÚC PHẦN VẼ HUÂN CHƯƠNG ---
-                } 
+                window.drawSnapshot(snapshot, cameraX, cameraY, alpha);
 
-                if (isPaused && currentGameState == GameState::PLAYING) { SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND); SDL_SetRenderDrawColor(renderer,0,0,0,150); SDL_Rect pO={0,0,SCREEN_WIDTH,SCREEN_HEIGHT}; SDL_RenderFillRect(renderer,&pO); SDL_Color pC={255,255,255,255}; string pT="PAUSED"; SDL_Surface* sP=TTF_RenderText_Solid(menuFont,pT.c_str(),pC); if(sP){SDL_Texture* tP=SDL_CreateTextureFromSurface(renderer,sP); SDL_Rect dP={(SCREEN_WIDTH-sP->w)/2,(SCREEN_HEIGHT-sP->h)/2,sP->w,sP->h}; SDL_RenderCopy(renderer,tP,NULL,&dP); SDL_DestroyTexture(tP); SDL_FreeSurface(sP);} }
-                else if (currentGameState == GameState::WON) { SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND); SDL_SetRenderDrawColor(renderer, 0, 180, 0, 170); SDL_Rect r={0,0,SCREEN_WIDTH,SCREEN_HEIGHT}; SDL_RenderFillRect(renderer,&r); SDL_Color c={255,255,0,255}; string t1="YOU WIN!"; string tS="FINAL SCORE: "+std::to_string(playerScore); string t2="Press Enter or ESC"; SDL_Surface* s1=TTF_RenderText_Solid(menuFont,t1.c_str(),c); SDL_Surface* sS=TTF_RenderText_Solid(uiFont,tS.c_str(),c); SDL_Surface* s2=TTF_RenderText_Solid(uiFont,t2.c_str(),c); int yP=SCREEN_HEIGHT/2-(s1?s1->h:0)-(sS?sS->h:0)-15; if(s1){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,s1); SDL_Rect d={(SCREEN_WIDTH-s1->w)/2, yP, s1->w,s1->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); SDL_FreeSurface(s1); yP+=d.h+5;} if(sS){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,sS); SDL_Rect d={(SCREEN_WIDTH-sS->w)/2, yP, sS->w,sS->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); SDL_FreeSurface(sS); yP+=d.h+15;} if(s2){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,s2); SDL_Rect d={(SCREEN_WIDTH-s2->w)/2, yP, s2->w,s2->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); SDL_FreeSurface(s2);} }
-                else if (currentGameState == GameState::GAME_OVER) { SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND); SDL_SetRenderDrawColor(renderer, 180, 0, 0, 170); SDL_Rect r={0,0,SCREEN_WIDTH,SCREEN_HEIGHT}; SDL_RenderFillRect(renderer,&r); SDL_Color c={255,255,255,255}; string t1="GAME OVER"; string tS="FINAL SCORE: "+std::to_string(playerScore); string t2="Press Enter or ESC"; SDL_Surface* s1=TTF_RenderText_Solid(menuFont,t1.c_str(),c); SDL_Surface* sS=TTF_RenderText_Solid(uiFont,tS.c_str(),c); SDL_Surface* s2=TTF_RenderText_Solid(uiFont,t2.c_str(),c); int yP=SCREEN_HEIGHT/2-(s1?s1->h:0)-(sS?sS->h:0)-15; if(s1){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,s1); SDL_Rect d={(SCREEN_WIDTH-s1->w)/2, yP, s1->w,s1->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); SDL_FreeSurface(s1); yP+=d.h+5;} if(sS){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,sS); SDL_Rect d={(SCREEN_WIDTH-sS->w)/2, yP, sS->w,sS->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); SDL_FreeSurface(sS); yP+=d.h+15;} if(s2){SDL_Texture* tx=SDL_CreateTextureFromSurface(renderer,s2); SDL_Rect d={(SCREEN_WIDTH-s2->w)/2, yP, s2->w,s2->h}; SDL_RenderCopy(renderer,tx,NULL,&d); SDL_DestroyTexture(tx); SDL_FreeSurface(s2);} }
+                // HUD và lớp phủ: texture vẽ sẵn, chỉ vẽ lại khi điểm/mạng/trạng thái đổi
+                window.flushSprites(); // Entity phải xong trước quad HUD
+                HudLayer::Overlay overlay = HudLayer::Overlay::NONE;
+                if (isPaused && currentGameState == GameState::PLAYING) overlay = HudLayer::Overlay::PAUSED;
+                else if (currentGameState == GameState::WON) overlay = HudLayer::Overlay::WON;
+                else if (currentGameState == GameState::GAME_OVER) overlay = HudLayer::Overlay::GAME_OVER;
+                hudLayer->update(snapshot.score, snapshot.lives, overlay);
+                hudLayer->render();
             } break; 
         } 
+        window.flushSprites(); // Chữ của menu
         window.display();
+        if (resolutionScaler) window.setResolutionScale(resolutionScaler->update(window.getLastRenderSeconds()));
 
-        float frameTicks_render = static_cast<float>(SDL_GetTicks()) - startTicks;
-        float desiredFrameTime_ms = 1000.0f / refreshRate;
-        if (frameTicks_render < desiredFrameTime_ms) { SDL_Delay(static_cast<Uint32>(desiredFrameTime_ms - frameTicks_render)); }
+        frameLimiter.wait();
 
     } 
 
     cout << "Cleaning up resources..." << endl;
+    delete sim; sim = nullptr; // Join thread mô phỏng trước khi hủy World/Player
+    world.player = nullptr;
     delete player_ptr; player_ptr = nullptr;
-    enemies_list.clear(); turrets_list.clear();
-    playerBulletsList.clear(); enemyBulletsList.clear();
 
-    Mix_FreeMusic(backgroundMusic); Mix_FreeChunk(shootSound); Mix_FreeChunk(gEnemyDeathSound); Mix_FreeChunk(gPlayerDeathSound); Mix_FreeChunk(gTurretExplosionSound); Mix_FreeChunk(gTurretShootSound);
-    SDL_DestroyTexture(menuBackgroundTexture); SDL_DestroyTexture(backgroundTexture); SDL_DestroyTexture(playerRunTexture); SDL_DestroyTexture(playerJumpTexture); SDL_DestroyTexture(playerEnterWaterTexture); SDL_DestroyTexture(playerSwimTexture); SDL_DestroyTexture(playerStandAimShootHorizTexture); SDL_DestroyTexture(playerRunAimShootHorizTexture); SDL_DestroyTexture(playerStandAimShootUpTexture); SDL_DestroyTexture(playerStandAimShootDiagUpTexture); SDL_DestroyTexture(playerRunAimShootDiagUpTexture); SDL_DestroyTexture(playerStandAimShootDiagDownTexture); SDL_DestroyTexture(playerRunAimShootDiagDownTexture); SDL_DestroyTexture(playerLyingDownTexture); SDL_DestroyTexture(playerLyingAimShootTexture); SDL_DestroyTexture(playerBulletTexture); SDL_DestroyTexture(turretBulletTexture); SDL_DestroyTexture(enemyTexture); SDL_DestroyTexture(gameTurretTexture); SDL_DestroyTexture(turretExplosionTexture);
-    SDL_DestroyTexture(lifeMedalTexture); // ĐÃ THÊM GIẢI PHÓNG
+    delete stageBackground; delete tileLayer; delete hudLayer; delete uiText; delete menuText; delete debugText; delete resolutionScaler;
+    gVoices = nullptr; delete voices; // Dừng mọi kênh trước khi giải phóng chunk
+    gAssets = nullptr; delete assets; // Giải phóng mọi texture/âm thanh, trước Mix_CloseAudio
 
     TTF_CloseFont(uiFont); TTF_CloseFont(menuFont); TTF_CloseFont(debugFont);
+    delete archive; // Sau mọi texture/chunk/font còn trỏ vào vùng map
 
     TTF_Quit(); Mix_CloseAudio(); Mix_Quit(); 
     window.cleanUp(); IMG_Quit(); SDL_Quit();
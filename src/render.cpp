@@ -0,0 +1,161 @@
+// Các hàm render của entity gameplay. File này chỉ build vào target `contra`:
+// contra_core giữ phần mô phỏng, không gọi tới SDL_Renderer.
+// collect() chạy trên thread mô phỏng, chỉ ghi sprite vào RenderSnapshot; RenderWindow::drawSnapshot()
+// chạy trên main thread, nội suy vị trí và gửi vào SpriteBatch.
+#include "RenderWindow.hpp"
+#include "RenderSnapshot.hpp"
+#include "player.hpp"
+#include "EnemyPool.hpp"
+#include "TurretPool.hpp"
+#include "BulletPool.hpp"
+#include "utils.hpp"
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    // Sprite nằm hẳn ngoài màn hình thì không gửi vào batch
+    bool offScreen(const RenderWindow& window, const SDL_Rect& r) {
+        return r.x >= window.getWidth() || r.x + r.w <= 0 || r.y >= window.getHeight() || r.y + r.h <= 0;
+    }
+
+    // Sprite nằm hẳn ngoài đoạn x [minX, maxX] thì không ghi vào snapshot
+    bool outsideSpan(float x, int w, float minX, float maxX) {
+        return x + w < minX || x > maxX;
+    }
+}
+
+// --- Snapshot ---
+void RenderWindow::drawSnapshot(const RenderSnapshot& snapshot, float cameraX, float cameraY, float alpha) {
+    for (const SpriteInstance& s : snapshot.sprites) {
+        SDL_Rect destRect = { static_cast<int>(round(utils::lerp(s.prevX, s.x, alpha) - cameraX)),
+                              static_cast<int>(round(utils::lerp(s.prevY, s.y, alpha) - cameraY)), s.w, s.h };
+        if (offScreen(*this, destRect)) continue;
+        spriteBatch.draw(s.texture, s.src, destRect, s.flipH, s.layer);
+    }
+
+    if (snapshot.debugRects.empty()) return;
+    // Vẽ trực tiếp, không qua batch: khung nằm dưới các sprite đã gom
+    SDL_SetRenderDrawColor(renderer, 255, 0, 255, 100); // Màu tím cho hitbox
+    for (SDL_Rect r : snapshot.debugRects) {
+        r.x = static_cast<int>(round(r.x - cameraX));
+        r.y = static_cast<int>(round(r.y - cameraY));
+        SDL_RenderDrawRect(renderer, &r);
+    }
+}
+
+// --- Player ---
+void Player::collect(RenderSnapshot& out) const {
+    if (currentState == PlayerState::DEAD && lives <= 0) return;
+    if (currentState == PlayerState::DYING && !isVisible) return;
+    // Sửa điều kiện này: Nếu DEAD, còn mạng, và KHÔNG invulnerable (nghĩa là chưa bắt đầu quá trình hồi sinh bằng cách set invul)
+    // thì không render. Khi respawn() được gọi, invulnerable sẽ là true.
+    if (currentState == PlayerState::DEAD && lives > 0 && !invulnerable) return;
+
+
+    const SpriteRegion* sheetToUse = nullptr;
+    switch(currentState) {
+        case PlayerState::IDLE: sheetToUse = &sprites.run.region; break;
+        case PlayerState::RUNNING: sheetToUse = &sprites.run.region; break;
+        case PlayerState::JUMPING: case PlayerState::FALLING: case PlayerState::DROPPING: sheetToUse = &sprites.jump.region; break;
+        case PlayerState::ENTERING_WATER: sheetToUse = &sprites.enterWater.region; break;
+        case PlayerState::SWIMMING: case PlayerState::WATER_JUMP: sheetToUse = &sprites.swim.region; break;
+        case PlayerState::STAND_AIM_HORIZ: sheetToUse = &sprites.standAimShootHoriz.region; break;
+        case PlayerState::RUN_AIM_HORIZ: sheetToUse = &sprites.runAimShootHoriz.region; break;
+        case PlayerState::STAND_AIM_UP: sheetToUse = &sprites.standAimShootUp.region; break;
+        case PlayerState::STAND_AIM_DIAG_UP: sheetToUse = &sprites.standAimShootDiagUp.region; break;
+        case PlayerState::RUN_AIM_DIAG_UP: sheetToUse = &sprites.runAimShootDiagUp.region; break;
+        case PlayerState::STAND_AIM_DIAG_DOWN: sheetToUse = &sprites.standAimShootDiagDown.region; break;
+        case PlayerState::RUN_AIM_DIAG_DOWN: sheetToUse = &sprites.runAimShootDiagDown.region; break;
+        case PlayerState::LYING_DOWN: sheetToUse = &sprites.lyingDown.region; break;
+        case PlayerState::LYING_AIM_SHOOT: sheetToUse = &sprites.lyingAimShoot.region; break;
+        case PlayerState::DYING: sheetToUse = &sprites.run.region; break; 
+        case PlayerState::DEAD: // Nếu DEAD và invulnerable (đang trong quá trình hồi sinh/vừa hồi sinh)
+             if(invulnerable) sheetToUse = &sprites.jump.region; // Hiển thị frame rơi/nhảy khi vừa hồi sinh
+             else return; // Trường hợp này đã được chặn ở trên, nhưng để an toàn
+             break;
+        default: sheetToUse = &sprites.run.region; break;
+    }
+
+    if (!sheetToUse || !*sheetToUse) { 
+        // Chỉ log lỗi nếu không phải là DEAD mà không invulnerable (trường hợp này là bình thường, không vẽ)
+         if (!(currentState == PlayerState::DEAD && !invulnerable)) {
+            std::cerr << "!!!! [RENDER PLAYER] Error: Texture is NULL for state " << static_cast<int>(currentState) << "." << std::endl;
+         }
+         return; 
+    }
+
+    if (invulnerable && currentState != PlayerState::DYING) { 
+        bool showPlayer = phys::floorToInt(invulnerableTimer / BLINK_INTERVAL) % 2 == 0; 
+        if (!showPlayer) return; 
+    }
+
+    SDL_Rect srcRect = sheetToUse->sub(currentSourceRect); // currentSourceRect tính theo toạ độ trong sheet
+    out.sprites.push_back({ sheetToUse->texture, srcRect, phys::toFloat(prevPos.x), phys::toFloat(prevPos.y), phys::toFloat(pos.x), phys::toFloat(pos.y),
+                            currentSourceRect.w, currentSourceRect.h,
+                            SpriteBatch::LAYER_PLAYER, facing == FacingDirection::LEFT });
+}
+
+// --- EnemyPool ---
+void EnemyPool::collect(RenderSnapshot& out, float minX, float maxX) const {
+    if (!sheet) return;
+    for (std::size_t i = 0; i < size(); ++i) {
+        if (state[i] == EnemyState::DEAD || (state[i] == EnemyState::DYING && !visible[i])) continue;
+        float x = phys::toFloat(posX[i]);
+        if (outsideSpan(x, frameWidth, minX, maxX)) continue;
+        SDL_Rect srcRect = sheet.frame(animFrame[i]);
+        out.sprites.push_back({ sheet.region.texture, srcRect, phys::toFloat(prevX[i]), phys::toFloat(prevY[i]), x, phys::toFloat(posY[i]),
+                                frameWidth, frameHeight, SpriteBatch::LAYER_ENEMIES, !movingRight[i] });
+    }
+}
+
+// --- TurretPool ---
+void TurretPool::collect(RenderSnapshot& out, float minX, float maxX) const {
+    // Chỉ duyệt đoạn turret quanh màn hình; nới thêm một frame nổ vì vụ nổ có thể rộng hơn ô turret
+    std::size_t first, last;
+    activeRange(minX - sheetFrameWidthExplosion, maxX + sheetFrameWidthExplosion, first, last);
+    for (std::size_t i = first; i < last; ++i) {
+        float x = phys::toFloat(posX[i]), y = phys::toFloat(posY[i]);
+
+        if (state[i] == TurretState::DESTROYED_ANIM ||
+            (state[i] == TurretState::FULLY_DESTROYED && animFrameExplosion[i] < NUM_FRAMES_EXPLOSION)) {
+            // Luôn render explosion nếu đang trong state DESTROYED_ANIM
+            // hoặc nếu là FULLY_DESTROYED nhưng animation chưa chạy hết frame cuối cùng.
+            if (!explosionSheet) continue;
+
+            // Explosion giữ kích thước gốc của frame, căn giữa theo ô của turret
+            float explosionX = x + (renderWidthTurret - sheetFrameWidthExplosion) / 2.0f;
+            float explosionY = y + (renderHeightTurret - sheetFrameHeightExplosion) / 2.0f;
+            SDL_Rect srcRect = explosionSheet.frame(animFrameExplosion[i]);
+            out.sprites.push_back({ explosionSheet.region.texture, srcRect, explosionX, explosionY, explosionX, explosionY,
+                                    sheetFrameWidthExplosion, sheetFrameHeightExplosion, SpriteBatch::LAYER_TURRETS, false });
+        } else if (state[i] != TurretState::FULLY_DESTROYED) { // Chỉ vẽ turret nếu chưa bị phá hủy hoàn toàn
+            if (turretSheet) {
+                SDL_Rect srcRect = turretSheet.frame(animFrameTurret[i]);
+                out.sprites.push_back({ turretSheet.region.texture, srcRect, x, y, x, y, renderWidthTurret, renderHeightTurret,
+                                        SpriteBatch::LAYER_TURRETS, false });
+            }
+        }
+
+        #ifdef DEBUG_DRAW_HITBOXES
+        if (state[i] != TurretState::DESTROYED_ANIM && state[i] != TurretState::FULLY_DESTROYED) {
+            out.debugRects.push_back(getWorldHitbox(i));
+        }
+        #endif
+    }
+}
+
+// --- BulletPool ---
+void BulletPool::collect(RenderSnapshot& out, float minX, float maxX) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        SpriteRegion spr = sprite(texId[i]);
+        if (!spr) continue;
+        float x = phys::toFloat(posX[i]);
+        if (outsideSpan(x, renderW[i], minX, maxX)) continue;
+
+        // Đạn dùng cả sheet làm source rect
+        out.sprites.push_back({ spr.texture, spr.rect, phys::toFloat(prevX[i]), phys::toFloat(prevY[i]), x, phys::toFloat(posY[i]),
+                                renderW[i], renderH[i], SpriteBatch::LAYER_BULLETS, false });
+    }
+}
@@ -1,14 +1,18 @@
 #include<SDL2/SDL.h>
 #include<SDL2/SDL_image.h>
 #include<iostream>
+#include<algorithm>
 
 #include "RenderWindow.hpp"
 #include "entity.hpp"
+#include "Qoi.hpp"
 
 using namespace std;
 
-RenderWindow::RenderWindow(const char* p_title, int p_w, int p_h)
-	:window(NULL), renderer(NULL)
+RenderWindow::RenderWindow(const char* p_title, int p_w, int p_h, bool p_vsync)
+	:window(NULL), renderer(NULL), width(p_w), height(p_h),
+	 lowResTarget(NULL), baseW(0), baseH(0), targetW(0), targetH(0), resolutionScale(1.0f), outputRect{ 0, 0, p_w, p_h },
+	 frameStart(0), lastRenderSeconds(0.0)
 {
 	window = SDL_CreateWindow(p_title, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, p_w, p_h, SDL_WINDOW_SHOWN);
 
@@ -17,13 +21,21 @@ RenderWindow::RenderWindow(const char* p_title, int p_w, int p_h)
 		cout << "Window failed to init. Error: " << SDL_GetError() << endl;
 	}
 
-	renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	Uint32 flags = SDL_RENDERER_ACCELERATED;
+	if (p_vsync) flags |= SDL_RENDERER_PRESENTVSYNC;
+	renderer = SDL_CreateRenderer(window, -1, flags);
 }
 
 SDL_Texture* RenderWindow::loadTexture(const char* p_filePath)
 {
 	SDL_Texture* texture = NULL;
-	texture = IMG_LoadTexture(renderer, p_filePath);
+	// Surface đúng định dạng renderer dùng thì upload không phải đổi pixel
+	SDL_Surface* surface = qoi::loadPreferred(p_filePath, qoi::preferredFormat(renderer));
+	if (surface != NULL)
+	{
+		texture = SDL_CreateTextureFromSurface(renderer, surface);
+		SDL_FreeSurface(surface);
+	}
 
 	if(texture == NULL)
 	{
@@ -36,16 +48,74 @@ int RenderWindow::getRefreshRate()
 {
 	int displayIndex = SDL_GetWindowDisplayIndex(window);
 	SDL_DisplayMode mode;
-	SDL_GetDisplayMode(displayIndex, 0, &mode);
+	if (displayIndex < 0 || SDL_GetCurrentDisplayMode(displayIndex, &mode) != 0) return 0;
 	return mode.refresh_rate;
 }
 
+bool RenderWindow::hasVsync() const
+{
+	SDL_RendererInfo info;
+	return renderer && SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+}
+
 void RenderWindow::cleanUp()
 {
+	SDL_DestroyTexture(lowResTarget);
+	lowResTarget = NULL;
 	SDL_DestroyWindow(window);
 }
+
+void RenderWindow::setInternalResolution(int p_baseW, int p_baseH)
+{
+	if (p_baseW <= 0 || p_baseH <= 0) { baseW = baseH = 0; }
+	else { baseW = p_baseW; baseH = p_baseH; }
+
+	outputRect = { 0, 0, width, height };
+	if (baseW > 0) {
+		// Phóng bằng bội số nguyên để pixel đều nhau; target lớn hơn cửa sổ thì thu nhỏ giữ tỉ lệ
+		int factor = std::min(width / baseW, height / baseH);
+		if (factor >= 1) { outputRect.w = baseW * factor; outputRect.h = baseH * factor; }
+		else if (baseW * height > baseH * width) { outputRect.h = baseH * width / baseW; }
+		else { outputRect.w = baseW * height / baseH; }
+		outputRect.x = (width - outputRect.w) / 2;
+		outputRect.y = (height - outputRect.h) / 2;
+	}
+	updateTarget();
+}
+
+void RenderWindow::setResolutionScale(float scale)
+{
+	resolutionScale = std::max(0.05f, std::min(scale, 1.0f));
+	updateTarget();
+}
+
+void RenderWindow::updateTarget()
+{
+	int w = baseW > 0 ? std::max(1, static_cast<int>(baseW * resolutionScale + 0.5f)) : 0;
+	int h = baseH > 0 ? std::max(1, static_cast<int>(baseH * resolutionScale + 0.5f)) : 0;
+	if (w == targetW && h == targetH && (lowResTarget || w == 0)) return;
+
+	SDL_DestroyTexture(lowResTarget);
+	lowResTarget = NULL;
+	targetW = targetH = 0;
+	if (w == 0) return;
+	lowResTarget = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+	if (lowResTarget == NULL) {
+		cout << "Failed to create render target " << w << "x" << h << ". Error: " << SDL_GetError() << endl;
+		return; // Vẽ thẳng vào backbuffer
+	}
+	SDL_SetTextureScaleMode(lowResTarget, SDL_ScaleModeNearest);
+	targetW = w; targetH = h;
+}
+
 void RenderWindow::clear()
 {
+	frameStart = SDL_GetPerformanceCounter();
+	if (lowResTarget) {
+		// Đổi target làm scale về 1: đặt lại mỗi frame để toạ độ logic phủ kín target
+		SDL_SetRenderTarget(renderer, lowResTarget);
+		SDL_RenderSetScale(renderer, static_cast<float>(targetW) / width, static_cast<float>(targetH) / height);
+	}
 	SDL_RenderClear(renderer);
 }
 void RenderWindow::render(entity& p_entity)
@@ -72,7 +142,28 @@ void RenderWindow::render(SDL_Texture* p_tex, const SDL_Rect& p_src, const SDL_R
 
 void RenderWindow::display()
 {
+	if (lowResTarget) {
+		SDL_SetRenderTarget(renderer, NULL);
+		if (outputRect.w != width || outputRect.h != height) {
+			Uint8 r, g, b, a;
+			SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+			SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+			SDL_RenderClear(renderer); // Viền đen quanh vùng hiển thị
+			SDL_SetRenderDrawColor(renderer, r, g, b, a);
+		}
+		SDL_RenderCopy(renderer, lowResTarget, NULL, &outputRect);
+	}
+
+	// Có vsync thì present chặn tới lần quét kế tiếp: không tính vào thời gian render
+	bool vsync = hasVsync();
+	if (vsync) lastRenderSeconds = static_cast<double>(SDL_GetPerformanceCounter() - frameStart) / SDL_GetPerformanceFrequency();
 	SDL_RenderPresent(renderer);
+	if (!vsync) lastRenderSeconds = static_cast<double>(SDL_GetPerformanceCounter() - frameStart) / SDL_GetPerformanceFrequency();
+}
+
+void RenderWindow::flushSprites()
+{
+    spriteBatch.flush(renderer);
 }
 
 SDL_Renderer* RenderWindow::getRenderer()
@@ -0,0 +1,13 @@
+#include "sfx.hpp"
+
+namespace {
+    sfx::PlayHandler gHandler = nullptr;
+}
+
+void sfx::setHandler(PlayHandler handler) {
+    gHandler = handler;
+}
+
+void sfx::play(SoundEffect effect, float x) {
+    if (gHandler) gHandler(effect, x);
+}
@@ -0,0 +1,213 @@
+// contra_pack: gom tài nguyên rời thành một archive đã giải mã sẵn (định dạng trong PackFormat.hpp) để game
+// map vào bộ nhớ lúc khởi động thay cho mở và giải mã từng file.
+//
+// Cách dùng:
+//   contra_pack OUTPUT INPUT...        (INPUT là file hoặc thư mục, thư mục được duyệt đệ quy)
+//   contra_pack res/assets.pak res/gfx res/snd res/font
+//
+// Tên entry là đường dẫn như khi truyền vào (vd. "res/gfx/Enemy.png"), trùng với đường dẫn game dùng khi load
+// file rời, nên phải chạy từ thư mục gốc như game. Ảnh (.png/.jpg/.bmp) lưu pixel RGBA32; .wav lưu PCM đã chuyển
+// sang định dạng mixer của game (pack::AUDIO_*); font, .ogg/.mp3 và .wav có "music" trong tên (nhạc nền, stream
+// bằng Mix_LoadMUS) lưu nguyên file.
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "PackFormat.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PackedFile {
+    std::string name;
+    pack::Entry entry;
+    std::vector<std::uint8_t> data;
+};
+
+std::string lowerExtension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext;
+}
+
+bool isMusic(const fs::path& path) {
+    std::string ext = lowerExtension(path);
+    return ext == ".ogg" || ext == ".mp3" || (ext == ".wav" && path.filename().string().find("music") != std::string::npos);
+}
+
+bool packImage(const std::string& name, PackedFile& file) {
+    SDL_Surface* loaded = IMG_Load(name.c_str());
+    if (!loaded) { std::cerr << "Failed to load " << name << ": " << IMG_GetError() << std::endl; return false; }
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, pack::IMAGE_FORMAT, 0);
+    SDL_FreeSurface(loaded);
+    if (!surface) { std::cerr << "Failed to convert " << name << ": " << SDL_GetError() << std::endl; return false; }
+
+    // Bỏ phần đệm cuối hàng: trong archive pitch luôn là width * 4
+    const std::size_t rowBytes = static_cast<std::size_t>(surface->w) * 4;
+    file.data.resize(rowBytes * surface->h);
+    for (int y = 0; y < surface->h; ++y)
+        std::memcpy(file.data.data() + y * rowBytes, static_cast<const std::uint8_t*>(surface->pixels) + y * surface->pitch, rowBytes);
+    file.entry.type = pack::EntryType::IMAGE;
+    file.entry.format = pack::IMAGE_FORMAT;
+    file.entry.width = surface->w;
+    file.entry.height = surface->h;
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+bool packSound(const std::string& name, PackedFile& file) {
+    SDL_AudioSpec spec;
+    Uint8* samples = nullptr;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(name.c_str(), &spec, &samples, &length)) { std::cerr << "Failed to load " << name << ": " << SDL_GetError() << std::endl; return false; }
+
+    // SDL_AudioStream đổi định dạng, số kênh và resample về đúng thứ Mix_OpenAudio của game dùng
+    SDL_AudioStream* stream = SDL_NewAudioStream(spec.format, spec.channels, spec.freq, pack::AUDIO_FORMAT, pack::AUDIO_CHANNELS, pack::AUDIO_FREQUENCY);
+    bool ok = stream && SDL_AudioStreamPut(stream, samples, static_cast<int>(length)) == 0 && SDL_AudioStreamFlush(stream) == 0;
+    if (ok) {
+        file.data.resize(static_cast<std::size_t>(SDL_AudioStreamAvailable(stream)));
+        ok = SDL_AudioStreamGet(stream, file.data.data(), static_cast<int>(file.data.size())) == static_cast<int>(file.data.size());
+    }
+    if (!ok) std::cerr << "Failed to convert " << name << ": " << SDL_GetError() << std::endl;
+    SDL_FreeAudioStream(stream);
+    SDL_FreeWAV(samples);
+
+    file.entry.type = pack::EntryType::SOUND;
+    file.entry.format = pack::AUDIO_FORMAT;
+    file.entry.width = pack::AUDIO_FREQUENCY;
+    file.entry.height = pack::AUDIO_CHANNELS;
+    return ok;
+}
+
+bool packBlob(const std::string& name, PackedFile& file) {
+    std::ifstream in(name, std::ios::binary);
+    if (!in) { std::cerr << "Failed to open " << name << std::endl; return false; }
+    file.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    file.entry.type = pack::EntryType::BLOB;
+    return true;
+}
+
+// false nếu file có đuôi được hỗ trợ nhưng đọc lỗi; file không hỗ trợ thì bỏ qua
+bool packFile(const fs::path& path, std::vector<PackedFile>& files) {
+    std::string ext = lowerExtension(path);
+    PackedFile file;
+    file.name = path.lexically_normal().generic_string();
+    file.entry = pack::Entry{};
+    bool ok;
+    if (isMusic(path) || ext == ".ttf" || ext == ".otf") ok = packBlob(file.name, file);
+    else if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") ok = packImage(file.name, file);
+    else if (ext == ".wav") ok = packSound(file.name, file);
+    else { std::cerr << "Skipping " << file.name << " (unsupported type)" << std::endl; return true; }
+    if (ok) files.push_back(std::move(file));
+    return ok;
+}
+
+std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool writeArchive(const std::string& output, std::vector<PackedFile>& files) {
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out) { std::cerr << "Cannot write " << output << std::endl; return false; }
+
+    auto padTo = [&out](std::uint64_t offset) {
+        static const char zeros[pack::DATA_ALIGNMENT] = {};
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        out.write(zeros, static_cast<std::streamsize>(offset - position));
+    };
+
+    pack::Header header{};
+    std::memcpy(header.magic, pack::MAGIC, sizeof(pack::MAGIC));
+    header.version = pack::VERSION;
+    header.entryCount = static_cast<std::uint32_t>(files.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Dữ liệu theo thứ tự tên, cùng thứ tự bảng Entry
+    std::uint64_t offset = sizeof(header);
+    for (PackedFile& file : files) {
+        offset = alignUp(offset, pack::DATA_ALIGNMENT);
+        padTo(offset);
+        file.entry.offset = offset;
+        file.entry.size = file.data.size();
+        out.write(reinterpret_cast<const char*>(file.data.data()), static_cast<std::streamsize>(file.data.size()));
+        offset += file.data.size();
+    }
+
+    header.namesOffset = offset;
+    std::uint32_t nameOffset = 0;
+    for (PackedFile& file : files) {
+        file.entry.nameOffset = nameOffset;
+        file.entry.nameLength = static_cast<std::uint32_t>(file.name.size());
+        out.write(file.name.data(), static_cast<std::streamsize>(file.name.size()));
+        nameOffset += file.entry.nameLength;
+    }
+    offset += nameOffset;
+
+    header.indexOffset = alignUp(offset, alignof(pack::Entry));
+    padTo(header.indexOffset);
+    for (const PackedFile& file : files) out.write(reinterpret_cast<const char*>(&file.entry), sizeof(pack::Entry));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: contra_pack OUTPUT INPUT..." << std::endl;
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+
+    std::vector<PackedFile> files;
+    bool ok = true;
+    for (int i = 2; i < argc; ++i) {
+        fs::path input = argv[i];
+        std::error_code error;
+        if (fs::is_directory(input, error)) {
+            std::vector<fs::path> paths;
+            for (const fs::directory_entry& item : fs::recursive_directory_iterator(input, error))
+                if (item.is_regular_file()) paths.push_back(item.path());
+            std::sort(paths.begin(), paths.end());
+            for (const fs::path& path : paths) ok = packFile(path, files) && ok;
+        } else if (fs::is_regular_file(input, error)) {
+            ok = packFile(input, files) && ok;
+        } else {
+            std::cerr << "No such file or directory: " << input.string() << std::endl;
+            ok = false;
+        }
+    }
+    IMG_Quit();
+    if (!ok) { std::cerr << "Archive not written." << std::endl; return 1; }
+
+    // Bảng Entry sắp theo tên để AssetArchive tìm nhị phân; cùng file truyền hai lần thì giữ một
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.name < b.name; });
+    files.erase(std::unique(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.name == b.name; }), files.end());
+    if (!writeArchive(argv[1], files)) return 1;
+
+    int counts[4] = {};
+    std::uint64_t bytes[4] = {};
+    for (const PackedFile& file : files) {
+        ++counts[static_cast<int>(file.entry.type)];
+        bytes[static_cast<int>(file.entry.type)] += file.entry.size;
+    }
+    auto megabytes = [](std::uint64_t n) { return static_cast<double>(n) / (1024.0 * 1024.0); };
+    std::cout << std::fixed << std::setprecision(2) << "Packed " << files.size() << " files into " << argv[1] << ": "
+              << counts[1] << " images (" << megabytes(bytes[1]) << " MB), "
+              << counts[2] << " sounds (" << megabytes(bytes[2]) << " MB PCM), "
+              << counts[3] << " blobs (" << megabytes(bytes[3]) << " MB)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,180 @@
+// contra_qoi: tạo file .qoi cạnh ảnh gốc để game giải mã nhanh hơn (qoi::loadPreferred dùng file .qoi nếu nó
+// không cũ hơn ảnh gốc), và đo thời gian giải mã PNG so với QOI trên chính ảnh của game.
+//
+// Cách dùng:
+//   contra_qoi INPUT...                      (INPUT là file hoặc thư mục, thư mục được duyệt đệ quy)
+//   contra_qoi res/gfx
+//   contra_qoi --bench [--reps N] INPUT...   (in CSV, không ghi file)
+//
+// Benchmark đọc file vào bộ nhớ trước rồi chỉ đo phần giải mã ra ARGB8888 (định dạng texture thường gặp), nên
+// không tính thời gian đọc đĩa. Mỗi ảnh giải mã N lần (mặc định 20), lấy thời gian nhanh nhất.
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Qoi.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr Uint32 BENCH_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+bool isImage(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp";
+}
+
+bool readFile(const std::string& path, std::vector<std::uint8_t>& data) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool samePixels(SDL_Surface* a, SDL_Surface* b) {
+    if (!a || !b || a->w != b->w || a->h != b->h || a->format->format != b->format->format) return false;
+    const std::size_t rowBytes = static_cast<std::size_t>(a->w) * a->format->BytesPerPixel;
+    for (int y = 0; y < a->h; ++y)
+        if (std::memcmp(static_cast<const std::uint8_t*>(a->pixels) + y * a->pitch, static_cast<const std::uint8_t*>(b->pixels) + y * b->pitch, rowBytes) != 0)
+            return false;
+    return true;
+}
+
+// Thời gian nhanh nhất (ms) của decode trong reps lần; surface của lần cuối trả qua last
+template<typename Decode>
+double bestTime(int reps, SDL_Surface*& last, Decode decode) {
+    double best = 0.0;
+    for (int i = 0; i < reps; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        SDL_Surface* surface = decode();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || ms < best) best = ms;
+        SDL_FreeSurface(last);
+        last = surface;
+        if (!surface) break;
+    }
+    return best;
+}
+
+bool convert(const std::string& name, std::uint64_t& sourceBytes, std::uint64_t& qoiBytes) {
+    SDL_Surface* surface = IMG_Load(name.c_str());
+    if (!surface) { std::cerr << "Failed to load " << name << ": " << IMG_GetError() << std::endl; return false; }
+    std::vector<std::uint8_t> encoded;
+    bool ok = qoi::encode(surface, encoded);
+    SDL_FreeSurface(surface);
+    if (!ok) { std::cerr << "Failed to encode " << name << ": " << SDL_GetError() << std::endl; return false; }
+
+    const std::string output = qoi::siblingPath(name);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    if (!out) { std::cerr << "Cannot write " << output << std::endl; return false; }
+
+    std::error_code error;
+    sourceBytes += fs::file_size(name, error);
+    qoiBytes += encoded.size();
+    std::cout << name << " -> " << output << std::endl;
+    return true;
+}
+
+bool bench(const std::string& name, int reps) {
+    std::vector<std::uint8_t> source;
+    if (!readFile(name, source)) { std::cerr << "Failed to open " << name << std::endl; return false; }
+
+    SDL_Surface* image = nullptr;
+    double imageMs = bestTime(reps, image, [&source]() -> SDL_Surface* {
+        SDL_Surface* loaded = IMG_Load_RW(SDL_RWFromConstMem(source.data(), static_cast<int>(source.size())), 1);
+        if (!loaded || loaded->format->format == BENCH_FORMAT) return loaded;
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, BENCH_FORMAT, 0);
+        SDL_FreeSurface(loaded);
+        return converted;
+    });
+    std::vector<std::uint8_t> encoded;
+    if (!image || !qoi::encode(image, encoded)) {
+        std::cerr << "Failed to decode " << name << ": " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(image);
+        return false;
+    }
+
+    SDL_Surface* decoded = nullptr;
+    double qoiMs = bestTime(reps, decoded, [&encoded]() { return qoi::decode(encoded.data(), encoded.size(), BENCH_FORMAT); });
+    const bool match = samePixels(image, decoded);
+    const double pixels = static_cast<double>(image->w) * image->h;
+    auto megapixelsPerSecond = [pixels](double ms) { return ms > 0.0 ? pixels / (ms * 1000.0) : 0.0; };
+
+    std::cout << name << ',' << image->w * image->h << ',' << source.size() << ',' << encoded.size() << ','
+              << imageMs << ',' << qoiMs << ',' << megapixelsPerSecond(imageMs) << ',' << megapixelsPerSecond(qoiMs) << ','
+              << (qoiMs > 0.0 ? imageMs / qoiMs : 0.0) << ',' << (match ? "ok" : "MISMATCH") << std::endl;
+    SDL_FreeSurface(image);
+    SDL_FreeSurface(decoded);
+    return match;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool benchMode = false;
+    int reps = 20;
+    std::vector<fs::path> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench") benchMode = true;
+        else if (arg == "--reps" && i + 1 < argc) reps = std::max(1, std::atoi(argv[++i]));
+        else inputs.push_back(arg);
+    }
+    if (inputs.empty()) {
+        std::cerr << "Usage: contra_qoi [--bench [--reps N]] INPUT..." << std::endl;
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+
+    std::vector<std::string> files;
+    bool ok = true;
+    for (const fs::path& input : inputs) {
+        std::error_code error;
+        if (fs::is_directory(input, error)) {
+            std::vector<fs::path> paths;
+            for (const fs::directory_entry& item : fs::recursive_directory_iterator(input, error))
+                if (item.is_regular_file() && isImage(item.path())) paths.push_back(item.path());
+            std::sort(paths.begin(), paths.end());
+            for (const fs::path& path : paths) files.push_back(path.lexically_normal().generic_string());
+        } else if (fs::is_regular_file(input, error)) {
+            files.push_back(input.lexically_normal().generic_string());
+        } else {
+            std::cerr << "No such file or directory: " << input.string() << std::endl;
+            ok = false;
+        }
+    }
+
+    if (benchMode) {
+        std::cout << std::fixed << std::setprecision(2)
+                  << "file,pixels,png_bytes,qoi_bytes,png_ms,qoi_ms,png_mpix_s,qoi_mpix_s,speedup,status" << std::endl;
+        for (const std::string& file : files) ok = bench(file, reps) && ok;
+    } else {
+        std::uint64_t sourceBytes = 0, qoiBytes = 0;
+        int converted = 0;
+        for (const std::string& file : files) {
+            if (!isImage(file)) { std::cerr << "Skipping " << file << " (unsupported type)" << std::endl; continue; }
+            if (convert(file, sourceBytes, qoiBytes)) ++converted;
+            else ok = false;
+        }
+        auto megabytes = [](std::uint64_t n) { return static_cast<double>(n) / (1024.0 * 1024.0); };
+        std::cout << std::fixed << std::setprecision(2) << "Converted " << converted << " images: "
+                  << megabytes(sourceBytes) << " MB -> " << megabytes(qoiBytes) << " MB QOI" << std::endl;
+    }
+    IMG_Quit();
+    return ok ? 0 : 1;
+}